@@ -33,6 +33,11 @@ public:
     virtual ~DRW_Interface() {
     }
 
+    /** Called while reading entities, reading stops with an error once it returns true. */
+    virtual bool isCancelled() {
+        return false;
+    }
+
     /** Called when header is parsed.  */
     virtual void addHeader(const DRW_Header* data) = 0;
 
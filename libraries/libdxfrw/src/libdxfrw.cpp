@@ -2030,6 +2030,9 @@ bool dxfRW::processDxf() {
 
     reader->setIgnoreComments( false);
     while (reader->readRec(&code)) {
+        if (iface->isCancelled()) {
+            return setError(DRW::BAD_CANCELLED);
+        }
         DRW_DBG(code); DRW_DBG(" code\n");
         /* at this level we should only get:
          999 - Comment
@@ -2503,6 +2506,9 @@ bool dxfRW::processEntities(bool isblock) {
         if (nextentity == "ENDSEC" || nextentity == "ENDBLK") {
             return true;  //found ENDSEC or ENDBLK terminate
         }
+        if (iface->isCancelled()) {
+            return setError(DRW::BAD_CANCELLED);
+        }
         if (nextentity == "LINE") {
             processed = processLine();
         }  else if (nextentity == "CIRCLE") {
@@ -60,7 +60,6 @@ void LC_ActionLayersToggleConstruction::trigger() {
             m_graphic->toggleLayerConstruction(m_layer);
             deselectEntities(m_layer);
         }
-        redrawDrawing();
     }
     finish(false);
 }
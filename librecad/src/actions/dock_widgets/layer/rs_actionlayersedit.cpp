@@ -60,7 +60,7 @@ void RS_ActionLayersEdit::trigger() {
     finish(false);
 
     // m_graphic->getLayerList()->getLayerWitget()->slotUpdateLayerList();
-    redrawDrawing();
+    // the view redraws entities of the edited layer as listener of the layer list
 }
 
 void RS_ActionLayersEdit::init(int status) {
@@ -57,7 +57,6 @@ void RS_ActionLayersToggleLock::trigger() {
             deselectEntitiesOnLockedLayer(m_layer);
         }
     }
-    redrawDrawing();
     finish(false);
 }
 
@@ -59,7 +59,6 @@ void RS_ActionLayersTogglePrint::trigger() {
             deselectEntities(m_layer);
         }
     }
-    redrawDrawing();
     finish(false);
 }
 
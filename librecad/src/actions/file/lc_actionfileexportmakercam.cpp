@@ -25,10 +25,9 @@
 #include "lc_actionfileexportmakercam.h"
 
 #include <QFile>
-#include <QTextStream>
 
 #include "lc_makercamsvg.h"
-#include "lc_xmlwriterqxmlstreamwriter.h"
+#include "lc_xmlwriterstream.h"
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
 #include "rs_dialogfactoryinterface.h"
@@ -43,11 +42,11 @@ namespace {
     }
 
 // create an SVG generator
-    std::unique_ptr<LC_MakerCamSVG> getGenerator()
+    std::unique_ptr<LC_MakerCamSVG> getGenerator(std::unique_ptr<LC_XMLWriterInterface> xmlWriter)
     {
         LC_GROUP_GUARD("ExportMakerCam");
         {
-            auto generator = std::make_unique<LC_MakerCamSVG>(std::make_unique<LC_XMLWriterQXmlStreamWriter>(),
+            auto generator = std::make_unique<LC_MakerCamSVG>(std::move(xmlWriter),
                                                               LC_GET_BOOL("ExportInvisibleLayers"),
                                                               LC_GET_BOOL("ExportConstructionLayers"),
                                                               LC_GET_BOOL("WriteBlocksInline"),
@@ -79,16 +78,17 @@ bool LC_ActionFileExportMakerCam::writeSvg(const QString& fileName, RS_Graphic&
         return false;
     }
 
-    auto generator = getGenerator();
-    if (generator->generate(&graphic)) {
-        QFile file{fileName};
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            LC_ERR<<__func__<<"(): failed in creating file "<<fileName<<", no SVG is generated";
-            return false;
-        }
+    QFile file{fileName};
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        LC_ERR<<__func__<<"(): failed in creating file "<<fileName<<", no SVG is generated";
+        return false;
+    }
 
-        QTextStream out(&file);
-        out << QString::fromStdString(generator->resultAsString());
+    // the document is streamed to the file while generated, so it is never kept in memory as a whole
+    auto generator = getGenerator(std::make_unique<LC_XMLWriterStream>(&file));
+    if (!generator->generate(&graphic)) {
+        LC_ERR<<__func__<<"(): failed in writing file "<<fileName;
+        return false;
     }
     return true;
 }
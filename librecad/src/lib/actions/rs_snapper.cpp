@@ -34,6 +34,7 @@
 #include "lc_graphicviewport.h"
 #include "lc_linemath.h"
 #include "lc_overlayentitiescontainer.h"
+#include "lc_profiler.h"
 #include "rs_debug.h"
 #include "rs_graphic.h"
 #include "rs_graphicview.h"
@@ -334,6 +335,7 @@ RS_Vector RS_Snapper::snapFree(QMouseEvent* e) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapPoint(QMouseEvent* e){
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionSnap);
     pImpData->snapSpot = RS_Vector(false);
     RS_Vector t(false);
 
@@ -711,6 +713,7 @@ RS_Vector RS_Snapper::restrictAngle(const RS_Vector &basePoint, const RS_Vector&
  */
 RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos,
                                    RS2::ResolveLevel level) {
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionPick);
 
     RS_DEBUG->print("RS_Snapper::catchEntity");
 
@@ -747,6 +750,7 @@ RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos,
  */
 RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos, RS2::EntityType enType,
                                    RS2::ResolveLevel level) {
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionPick, enType);
 
     RS_DEBUG->print("RS_Snapper::catchEntity");
 //                    std::cout<<"RS_Snapper::catchEntity(): enType= "<<enType<<std::endl;
@@ -0,0 +1,284 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_profiler.h"
+
+#include <chrono>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include "rs_debug.h"
+
+std::atomic<bool> LC_Profiler::s_enabled{false};
+
+namespace {
+    const std::chrono::steady_clock::time_point g_profilerOrigin = std::chrono::steady_clock::now();
+
+    QJsonObject histogramToJson(unsigned long long count, long long totalNs, long long maxNs,
+                                const unsigned long long* buckets, int bucketsCount) {
+        QJsonObject result;
+        result["count"] = static_cast<double>(count);
+        result["totalMs"] = totalNs * 1e-6;
+        result["maxMs"] = maxNs * 1e-6;
+        result["averageUs"] = count > 0 ? (totalNs * 1e-3) / count : 0.0;
+        QJsonArray bucketsArray;
+        for (int i = 0; i < bucketsCount; i++) {
+            if (buckets[i] > 0) {
+                QJsonObject bucket;
+                bucket["belowUs"] = static_cast<double>(1ULL << i);
+                bucket["count"] = static_cast<double>(buckets[i]);
+                bucketsArray.append(bucket);
+            }
+        }
+        result["buckets"] = bucketsArray;
+        return result;
+    }
+
+    bool writeJson(const QString& fileName, const QJsonObject& root) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            LC_ERR << "LC_Profiler: can't open file for writing: " << fileName;
+            return false;
+        }
+        const QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Compact);
+        return file.write(data) == data.size();
+    }
+}
+
+LC_Profiler* LC_Profiler::instance() {
+    static LC_Profiler profiler;
+    return &profiler;
+}
+
+long long LC_Profiler::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_profilerOrigin).count();
+}
+
+const char* LC_Profiler::sectionName(Section section) {
+    switch (section) {
+        case SectionFrame:
+            return "Frame";
+        case SectionBackground:
+            return "LayerBackground";
+        case SectionEntities:
+            return "LayerEntities";
+        case SectionOverlays:
+            return "LayerOverlays";
+        case SectionEntityDraw:
+            return "EntityDraw";
+        case SectionSetPen:
+            return "SetPen";
+        case SectionSnap:
+            return "Snap";
+        case SectionPick:
+            return "Pick";
+        case SectionRegeneration:
+            return "Regeneration";
+        default:
+            return "Unknown";
+    }
+}
+
+void LC_Profiler::Histogram::add(long long durationNs) {
+    long long us = durationNs / 1000;
+    int bucket = 0;
+    while (bucket < BUCKETS_COUNT - 1 && (1LL << bucket) <= us) {
+        bucket++;
+    }
+    buckets[bucket]++;
+    count++;
+    totalNs += durationNs;
+    if (durationNs > maxNs) {
+        maxNs = durationNs;
+    }
+}
+
+void LC_Profiler::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void LC_Profiler::reset() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_histograms = {};
+    m_frameHistograms = {};
+    for (auto& byType: m_byEntityType) {
+        byType.clear();
+    }
+    m_frames.clear();
+    m_currentFrame = {};
+    m_inFrame = false;
+    m_traceEvents.clear();
+}
+
+void LC_Profiler::beginFrame() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_currentFrame = {};
+    m_currentFrame.startNs = nowNs();
+    m_inFrame = true;
+}
+
+void LC_Profiler::endFrame() {
+    long long startNs = 0;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (!m_inFrame) {
+            return;
+        }
+        startNs = m_currentFrame.startNs;
+    }
+    // frame itself is a sample, that also finalizes the frame record
+    addSample(SectionFrame, startNs, nowNs() - startNs);
+}
+
+int LC_Profiler::threadIndex() {
+    auto id = std::this_thread::get_id();
+    auto it = m_threadIndexes.find(id);
+    if (it != m_threadIndexes.end()) {
+        return it->second;
+    }
+    int index = static_cast<int>(m_threadIndexes.size()) + 1;
+    m_threadIndexes[id] = index;
+    return index;
+}
+
+void LC_Profiler::addSample(Section section, long long startNs, long long durationNs, int entityType) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_histograms[section].add(durationNs);
+    if (entityType >= 0) {
+        m_byEntityType[section][entityType].add(durationNs);
+    }
+
+    // entities and pens are too numerous for the trace, they are collected by histograms only
+    if (section != SectionEntityDraw && section != SectionSetPen && m_traceEvents.size() < MAX_TRACE_EVENTS) {
+        m_traceEvents.push_back({section, entityType, startNs, durationNs, threadIndex()});
+    }
+
+    if (m_inFrame) {
+        if (section == SectionFrame) {
+            m_currentFrame.durationNs = durationNs;
+            m_currentFrame.sectionNs[section] = durationNs;
+            m_currentFrame.sectionSamples[section] = 1;
+            for (int i = 0; i < SectionsCount; i++) {
+                if (m_currentFrame.sectionSamples[i] > 0) {
+                    m_frameHistograms[i].add(m_currentFrame.sectionNs[i]);
+                }
+            }
+            if (m_frames.size() >= MAX_FRAMES) {
+                m_frames.pop_front();
+            }
+            m_frames.push_back(m_currentFrame);
+            m_inFrame = false;
+        }
+        else {
+            m_currentFrame.sectionNs[section] += durationNs;
+            m_currentFrame.sectionSamples[section]++;
+        }
+    }
+}
+
+/**
+ * Exports collected statistics (histograms, per entity type breakdown and recent frames) as JSON file.
+ */
+bool LC_Profiler::exportJson(const QString& fileName) const {
+    QJsonObject root;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        QJsonObject sections;
+        for (int i = 0; i < SectionsCount; i++) {
+            const Histogram& samples = m_histograms[i];
+            if (samples.count == 0) {
+                continue;
+            }
+            QJsonObject section;
+            section["samples"] = histogramToJson(samples.count, samples.totalNs, samples.maxNs,
+                                                 samples.buckets.data(), Histogram::BUCKETS_COUNT);
+            const Histogram& perFrame = m_frameHistograms[i];
+            if (perFrame.count > 0) {
+                section["perFrame"] = histogramToJson(perFrame.count, perFrame.totalNs, perFrame.maxNs,
+                                                      perFrame.buckets.data(), Histogram::BUCKETS_COUNT);
+            }
+            QJsonArray byType;
+            for (const auto& [type, histogram]: m_byEntityType[i]) {
+                QJsonObject typeStats = histogramToJson(histogram.count, histogram.totalNs, histogram.maxNs,
+                                                        histogram.buckets.data(), Histogram::BUCKETS_COUNT);
+                typeStats["entityType"] = type;
+                byType.append(typeStats);
+            }
+            if (!byType.isEmpty()) {
+                section["byEntityType"] = byType;
+            }
+            sections[sectionName(static_cast<Section>(i))] = section;
+        }
+        root["sections"] = sections;
+
+        QJsonArray frames;
+        for (const FrameRecord& frame: m_frames) {
+            QJsonObject frameObject;
+            frameObject["startMs"] = frame.startNs * 1e-6;
+            frameObject["durationMs"] = frame.durationNs * 1e-6;
+            for (int i = 0; i < SectionsCount; i++) {
+                if (i != SectionFrame && frame.sectionSamples[i] > 0) {
+                    QJsonObject sectionTotal;
+                    sectionTotal["ms"] = frame.sectionNs[i] * 1e-6;
+                    sectionTotal["samples"] = static_cast<int>(frame.sectionSamples[i]);
+                    frameObject[sectionName(static_cast<Section>(i))] = sectionTotal;
+                }
+            }
+            frames.append(frameObject);
+        }
+        root["frames"] = frames;
+    }
+    return writeJson(fileName, root);
+}
+
+/**
+ * Exports trace of coarse sections in Chrome trace event format (chrome://tracing, Perfetto).
+ */
+bool LC_Profiler::exportChromeTrace(const QString& fileName) const {
+    QJsonArray events;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        for (const TraceEvent& traceEvent: m_traceEvents) {
+            QJsonObject event;
+            event["name"] = sectionName(traceEvent.section);
+            event["cat"] = "librecad";
+            event["ph"] = "X";
+            event["ts"] = traceEvent.startNs * 1e-3;
+            event["dur"] = traceEvent.durationNs * 1e-3;
+            event["pid"] = 1;
+            event["tid"] = traceEvent.threadIndex;
+            if (traceEvent.entityType >= 0) {
+                QJsonObject args;
+                args["entityType"] = traceEvent.entityType;
+                event["args"] = args;
+            }
+            events.append(event);
+        }
+    }
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+    return writeJson(fileName, root);
+}
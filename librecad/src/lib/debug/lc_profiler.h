@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_PROFILER_H
+#define LC_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class QString;
+
+#define LC_PROFILER LC_Profiler::instance()
+
+/**
+ * Runtime profiler for rendering and interaction. When disabled (default), each measured scope costs a single check
+ * of the flag, so it may be kept in release builds and enabled for a session when a slow drawing should be analyzed.
+ *
+ * Collected data:
+ * <ul>
+ *  <li>histograms of durations of individual samples of each section;</li>
+ *  <li>per-frame totals of sections (a frame is single render pass of the view) and histograms of these totals;</li>
+ *  <li>per entity type breakdown of samples (entity draw time is inclusive, so for inserts it includes children);</li>
+ *  <li>trace of coarse sections (frames, layers, snap, pick, regeneration) for Chrome trace viewer.</li>
+ * </ul>
+ * Samples may be added from any thread.
+ */
+class LC_Profiler {
+public:
+    enum Section {
+        SectionFrame,         // render pass of the view
+        SectionBackground,    // grid and other background items
+        SectionEntities,      // drawing layer
+        SectionOverlays,      // previews, snapper and other overlays
+        SectionEntityDraw,    // drawing of single entity
+        SectionSetPen,        // resolving and setting pen of the entity
+        SectionSnap,          // snapping of mouse position
+        SectionPick,          // catching of entity under the cursor
+        SectionRegeneration,  // update of inserts and hatches
+        SectionsCount
+    };
+
+    /**
+     * Measures time of the scope and adds it as a sample of the section, if profiler is enabled.
+     */
+    class Scope {
+    public:
+        explicit Scope(Section section, int entityType = -1)
+            : m_section(section), m_entityType(entityType), m_active(isEnabled()) {
+            if (m_active) {
+                m_startNs = nowNs();
+            }
+        }
+        ~Scope() {
+            if (m_active) {
+                LC_PROFILER->addSample(m_section, m_startNs, nowNs() - m_startNs, m_entityType);
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Section m_section;
+        int m_entityType;
+        bool m_active;
+        long long m_startNs = 0;
+    };
+
+    LC_Profiler(const LC_Profiler&) = delete;
+    LC_Profiler& operator=(const LC_Profiler&) = delete;
+
+    static LC_Profiler* instance();
+    static bool isEnabled() {return s_enabled.load(std::memory_order_relaxed);}
+    static long long nowNs();
+    static const char* sectionName(Section section);
+
+    void setEnabled(bool enabled);
+    void reset();
+    void beginFrame();
+    void endFrame();
+    void addSample(Section section, long long startNs, long long durationNs, int entityType = -1);
+
+    bool exportJson(const QString& fileName) const;
+    bool exportChromeTrace(const QString& fileName) const;
+
+private:
+    LC_Profiler() = default;
+
+    /**
+     * Logarithmic histogram, bucket i holds samples with duration below 2^i microseconds
+     */
+    struct Histogram {
+        static constexpr int BUCKETS_COUNT = 32;
+        std::array<unsigned long long, BUCKETS_COUNT> buckets{};
+        unsigned long long count = 0;
+        long long totalNs = 0;
+        long long maxNs = 0;
+        void add(long long durationNs);
+    };
+
+    struct FrameRecord {
+        long long startNs = 0;
+        long long durationNs = 0;
+        std::array<long long, SectionsCount> sectionNs{};
+        std::array<unsigned, SectionsCount> sectionSamples{};
+    };
+
+    struct TraceEvent {
+        Section section;
+        int entityType;
+        long long startNs;
+        long long durationNs;
+        int threadIndex;
+    };
+
+    static constexpr size_t MAX_FRAMES = 2000;
+    static constexpr size_t MAX_TRACE_EVENTS = 200000;
+
+    static std::atomic<bool> s_enabled;
+
+    int threadIndex();
+
+    mutable std::mutex m_mutex;
+    std::array<Histogram, SectionsCount> m_histograms;
+    std::array<Histogram, SectionsCount> m_frameHistograms;
+    std::array<std::map<int, Histogram>, SectionsCount> m_byEntityType;
+    std::deque<FrameRecord> m_frames;
+    FrameRecord m_currentFrame;
+    bool m_inFrame = false;
+    std::vector<TraceEvent> m_traceEvents;
+    std::map<std::thread::id, int> m_threadIndexes;
+};
+
+#endif // LC_PROFILER_H
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_selectionset.h"
+#include "rs_entity.h"
+
+LC_SelectionSet::~LC_SelectionSet() {
+    clear();
+}
+
+/**
+ * Adds entity to the set. If the entity is tracked by another selection set,
+ * it is moved from that set to this one.
+ * @param nested true for entities of sub-containers (inserts, polylines etc.) of the document
+ */
+void LC_SelectionSet::add(RS_Entity *entity, bool nested) {
+    if (entity == nullptr) {
+        return;
+    }
+    if (entity->m_selectionSet == this && (nested ? m_nestedEntities : m_entities).count(entity) > 0) {
+        return;
+    }
+    if (entity->m_selectionSet != nullptr) {
+        entity->m_selectionSet->remove(entity);
+    }
+    RS2::EntityType type = entity->rtti();
+    if (nested) {
+        m_nestedEntities.emplace(entity, type);
+    } else {
+        m_entities.emplace(entity, type);
+    }
+    entity->m_selectionSet = this;
+}
+
+void LC_SelectionSet::remove(RS_Entity *entity) {
+    if (entity == nullptr || entity->m_selectionSet != this) {
+        return;
+    }
+    if (m_entities.erase(entity) == 0) {
+        m_nestedEntities.erase(entity);
+    }
+    entity->m_selectionSet = nullptr;
+}
+
+/**
+ * Detaches all tracked entities from the set. Selection flags of entities are not changed.
+ */
+void LC_SelectionSet::clear() {
+    for (const auto& [entity, type]: m_entities) {
+        entity->m_selectionSet = nullptr;
+    }
+    for (const auto& [entity, type]: m_nestedEntities) {
+        entity->m_selectionSet = nullptr;
+    }
+    m_entities.clear();
+    m_nestedEntities.clear();
+}
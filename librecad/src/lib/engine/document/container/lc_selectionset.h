@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_SELECTIONSET_H
+#define LC_SELECTIONSET_H
+
+#include <unordered_map>
+
+#include "rs.h"
+
+class RS_Entity;
+
+/**
+ * Set of selected entities of a document, maintained incrementally.
+ *
+ * Entities register themselves in the selection set of their document from
+ * RS_Entity::setSelected() and unregister on deselection, removal from the document or
+ * destruction. Entities of sub-containers (inserts, polylines etc.) are tracked apart from
+ * entities of the document itself, as nested ones. So selection queries of the document (count, selected length, collecting selected
+ * entities) depend on the amount of selected entities rather than on the size of the drawing.
+ *
+ * Only the flag is tracked, so entities that are flagged as selected but are not visible
+ * (for example, on frozen layer) are still included and should be filtered by RS_Entity::isSelected().
+ */
+class LC_SelectionSet {
+public:
+    LC_SelectionSet() = default;
+    ~LC_SelectionSet();
+    LC_SelectionSet(const LC_SelectionSet&) = delete;
+    LC_SelectionSet& operator=(const LC_SelectionSet&) = delete;
+
+    void add(RS_Entity* entity, bool nested = false);
+    void remove(RS_Entity* entity);
+    void clear();
+
+    bool isEmpty() const {return m_entities.empty() && m_nestedEntities.empty();}
+    /** @return amount of tracked entities of the document itself, without nested ones */
+    size_t size() const {return m_entities.size();}
+    bool contains(RS_Entity* entity) const {return m_entities.count(entity) > 0;}
+    /** tracked entities of the document with their types (type is kept so it's available during entity destruction) */
+    const std::unordered_map<RS_Entity*, RS2::EntityType>& getEntities() const {return m_entities;}
+    /** tracked entities of sub-containers of the document, at any depth */
+    const std::unordered_map<RS_Entity*, RS2::EntityType>& getNestedEntities() const {return m_nestedEntities;}
+private:
+    std::unordered_map<RS_Entity*, RS2::EntityType> m_entities;
+    std::unordered_map<RS_Entity*, RS2::EntityType> m_nestedEntities;
+};
+
+#endif // LC_SELECTIONSET_H
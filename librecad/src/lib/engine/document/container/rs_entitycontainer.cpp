@@ -24,7 +24,10 @@
 **
 **********************************************************************/
 
+#include <atomic>
 #include <QList>
+#include <QThread>
+#include <QThreadPool>
 #include <iostream>
 #include "rs_entitycontainer.h"
 
@@ -32,12 +35,15 @@
 #include <set>
 
 #include "lc_looputils.h"
+#include "lc_selectionset.h"
 #include "qg_dialogfactory.h"
 #include "rs_constructionline.h"
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
 #include "rs_dimension.h"
 #include "rs_ellipse.h"
+#include "rs_fontlist.h"
+#include "rs_graphic.h"
 #include "rs_information.h"
 #include "rs_insert.h"
 #include "rs_layer.h"
@@ -53,6 +59,39 @@ namespace {
 // the tolerance used to check topology of contours in hatching
     constexpr double contourTolerance = 1e-8;
 
+// below this count dimensions are regenerated in the calling thread, starting workers costs more than it saves
+    constexpr size_t parallelDimensionsThreshold = 256;
+
+// Collects dimensions of the container and its sub containers. Leaders are not collected, but updated in place.
+    void collectDimensions(RS_EntityContainer* container, std::vector<RS_Dimension*>& dimensions) {
+        for (RS_Entity *e: *container) {
+            if (RS_Information::isDimension(e->rtti())) {
+                dimensions.push_back(static_cast<RS_Dimension*>(e));
+            } else if (e->rtti() == RS2::EntityDimLeader) {
+                e->update();
+            } else if (e->isContainer()) {
+                collectDimensions(static_cast<RS_EntityContainer*>(e), dimensions);
+            }
+        }
+    }
+
+// Collects names of fonts set by \f{name} or \F{name} codes of an mtext, the way RS_MText::update() reads them.
+    void collectTextFonts(const QString& text, std::set<QString>& fonts) {
+        for (qsizetype i = 0; i + 1 < text.length(); i++) {
+            if (text.at(i) != '\\') {
+                continue;
+            }
+            const QChar code = text.at(++i);
+            if ((code == 'f' || code == 'F') && i + 1 < text.length() && text.at(i + 1) == '{') {
+                qsizetype end = text.indexOf('}', i + 1);
+                if (end > i + 1) {
+                    fonts.insert(text.mid(i + 2, end - i - 2));
+                    i = end;
+                }
+            }
+        }
+    }
+
 // For validate hatch contours, whether an entity in the contour is a closed
 // loop itself
     bool isClosedLoop(RS_Entity &entity) {
@@ -158,6 +197,8 @@ RS_EntityContainer& RS_EntityContainer::operator = (RS_EntityContainer&& other)
  * Destructor.
  */
 RS_EntityContainer::~RS_EntityContainer() {
+    // entities are not deleted if not owned, so they should not refer the selection set anymore
+    m_selectionSet.reset();
     if (autoDelete) {
         while (!m_entities.isEmpty())
             delete m_entities.takeFirst();
@@ -483,6 +524,7 @@ void RS_EntityContainer::addEntity(RS_Entity *entity) {
     } else {
         m_entities.append(entity);
     }
+    trackSelection(entity);
     if (m_autoUpdateBorders) {
         adjustBorders(entity);
     }
@@ -496,6 +538,7 @@ void RS_EntityContainer::appendEntity(RS_Entity *entity) {
     if (entity == nullptr)
         return;
     m_entities.append(entity);
+    trackSelection(entity);
     if (m_autoUpdateBorders)
         adjustBorders(entity);
 }
@@ -508,6 +551,7 @@ void RS_EntityContainer::prependEntity(RS_Entity *entity) {
     if (entity == nullptr)
         return;
     m_entities.prepend(entity);
+    trackSelection(entity);
     if (m_autoUpdateBorders)
         adjustBorders(entity);
 }
@@ -557,6 +601,7 @@ void RS_EntityContainer::insertEntity(int index, RS_Entity *entity) {
         return;
 
     m_entities.insert(index, entity);
+    trackSelection(entity);
 
     if (m_autoUpdateBorders) {
         adjustBorders(entity);
@@ -592,13 +637,18 @@ bool RS_EntityContainer::removeEntity(RS_Entity *entity) {
     //RLZ TODO: in Q3PtrList if 'entity' is nullptr remove the current item-> at.(entIdx)
     //    and sets 'entIdx' in next() or last() if 'entity' is the last item in the list.
     //    in LibreCAD is never called with nullptr
+    // only an entity on the borders can shrink them, check before it's deleted
+    bool shrinksBorders = m_autoUpdateBorders && isBorderEntity(entity);
     bool ret = m_entities.removeOne(entity);
+    if (ret) {
+        untrackSelection(entity);
+    }
 
     if (autoDelete && ret) {
         delete entity;
     }
-    if (m_autoUpdateBorders) {
-        calculateBorders();
+    if (ret && shrinksBorders) {
+        invalidateBorders();
     }
     return ret;
 }
@@ -607,6 +657,9 @@ bool RS_EntityContainer::removeEntity(RS_Entity *entity) {
  * Erases all entities in this container and resets the borders..
  */
 void RS_EntityContainer::clear() {
+    if (m_selectionSet != nullptr) {
+        m_selectionSet->clear();
+    }
     if (autoDelete) {
         while (!m_entities.isEmpty()) {
             RS_Entity * en = m_entities.takeFirst();
@@ -642,14 +695,31 @@ unsigned RS_EntityContainer::countSelected(bool deep, QList<RS2::EntityType> con
     unsigned count = 0;
     std::set<RS2::EntityType> type{types.cbegin(), types.cend()};
 
+    if (m_selectionSet != nullptr) {
+        // only selected entities are enumerated; entities hidden by their layers are not counted
+        for (const auto& [entity, entityType]: m_selectionSet->getEntities()) {
+            if (entity->isSelected() && (types.empty() || type.count(entityType))) {
+                count++;
+            }
+        }
+        if (deep) {
+            for (const auto& [entity, entityType]: m_selectionSet->getNestedEntities()) {
+                if (entity->isSelected() && (types.empty() || type.count(entityType))) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
     for (RS_Entity *entity: *this) {
 
         if (entity->isSelected())
             if (!types.size() || type.count(entity->rtti()))
                 count++;
 
-        if (entity->isContainer())
-            count += dynamic_cast<RS_EntityContainer *>(entity)->countSelected(deep); // fixme - hm... - what about entity types there? and deep flag?
+        if (deep && entity->isContainer())
+            count += static_cast<RS_EntityContainer *>(entity)->countSelected(deep, types);
     }
 
     return count;
@@ -658,6 +728,16 @@ unsigned RS_EntityContainer::countSelected(bool deep, QList<RS2::EntityType> con
 void RS_EntityContainer::collectSelected(std::vector<RS_Entity*> &collect, bool deep, QList<RS2::EntityType> const &types) {    
     std::set<RS2::EntityType> type{types.cbegin(), types.cend()};
 
+    // tracked entities are collected in the order of the container (which is the draw order),
+    // so enumeration stops as soon as the last tracked entity is reached
+    size_t remaining = 0;
+    if (m_selectionSet != nullptr) {
+        remaining = m_selectionSet->size();
+        if (remaining == 0) {
+            return;
+        }
+    }
+
     for (RS_Entity *e: m_entities) {
         if (e != nullptr) {
             if (e->isSelected()) {
@@ -669,50 +749,160 @@ void RS_EntityContainer::collectSelected(std::vector<RS_Entity*> &collect, bool
                     container->collectSelected(collect, false); // todo - check whether we need deep and types?
                 }
             }
+            if (m_selectionSet != nullptr && m_selectionSet->contains(e) && --remaining == 0) {
+                return;
+            }
         }
     }
 }
-// fixme - sand - avoid usage in actions as it enumerates all entities. Rework or rely on entities list!!!!
+
 RS_EntityContainer::LC_SelectionInfo RS_EntityContainer::getSelectionInfo(/*bool deep, */const QList<RS2::EntityType> &types) {
     LC_SelectionInfo result;
 
     std::set<RS2::EntityType> type{types.cbegin(), types.cend()};
 
-    for (RS_Entity *e: *this) {
-        if (e != nullptr) {
-            if (e->isSelected()) {
-                if (types.empty() || type.count(e->rtti())) {
-                    result.count ++;
-                    double entityLength = e->getLength();
-                    if (entityLength >= 0.) {
-                        result.length += entityLength;
-                    }
+    auto addToInfo = [&result, &types, &type](RS_Entity* e, RS2::EntityType entityType) {
+        if (e->isSelected()) {
+            if (types.empty() || type.count(entityType)) {
+                result.count ++;
+                double entityLength = e->getLength();
+                if (entityLength >= 0.) {
+                    result.length += entityLength;
                 }
             }
         }
+    };
+
+    if (m_selectionSet != nullptr) {
+        for (const auto& [entity, entityType]: m_selectionSet->getEntities()) {
+            addToInfo(entity, entityType);
+        }
+        return result;
+    }
+
+    for (RS_Entity *e: *this) {
+        if (e != nullptr) {
+            addToInfo(e, e->rtti());
+        }
     }
 
     return result;
 }
 
-// fixme - sand - avoid usage in actions as it enumerates all entities. Rework or rely on entities list!!!!
 /**
- * Counts the selected entities in this container.
+ * @return Total length of the selected entities in this container.
  */
 double RS_EntityContainer::totalSelectedLength() {
     double ret(0.0);
-    for (RS_Entity *e: *this) {
-
+    auto addLength = [&ret](RS_Entity* e) {
         if (e->isVisible() && e->isSelected()) {
             double l = e->getLength();
             if (l >= 0.) {
                 ret += l;
             }
         }
+    };
+
+    if (m_selectionSet != nullptr) {
+        for (const auto& [entity, entityType]: m_selectionSet->getEntities()) {
+            addLength(entity);
+        }
+        return ret;
+    }
+
+    for (RS_Entity *e: *this) {
+        addLength(e);
     }
     return ret;
 }
 
+/**
+ * Enables incremental tracking of selected entities. Selection queries of the container
+ * (getSelectionInfo(), totalSelectedLength()) then enumerate selected entities only instead
+ * of the whole container, and collectSelected() stops after the last selected entity.
+ * Selected entities of sub-containers are tracked as nested ones, so countSelected() does not
+ * walk the container at all.
+ */
+void RS_EntityContainer::enableSelectionTracking() {
+    if (m_selectionSet != nullptr) {
+        return;
+    }
+    m_selectionSet = std::make_unique<LC_SelectionSet>();
+    for (RS_Entity *e: std::as_const(m_entities)) {
+        trackSelection(e);
+    }
+}
+
+/**
+ * @return selection set of this container or of the nearest document containing it,
+ * nullptr if there is none.
+ */
+LC_SelectionSet* RS_EntityContainer::findSelectionSet() const {
+    for (const RS_EntityContainer* c = this; c != nullptr; c = c->getParent()) {
+        if (c->m_selectionSet != nullptr) {
+            return c->m_selectionSet.get();
+        }
+        if (c->isDocument()) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Registers added entity and its selected sub-entities in the selection set,
+ * if they are already selected.
+ */
+void RS_EntityContainer::trackSelection(RS_Entity *entity) {
+    if (entity == nullptr) {
+        return;
+    }
+    LC_SelectionSet* selectionSet = findSelectionSet();
+    if (selectionSet == nullptr) {
+        return;
+    }
+    if (entity->getFlag(RS2::FlagSelected)) {
+        selectionSet->add(entity, selectionSet != m_selectionSet.get());
+    }
+    trackNestedSelection(selectionSet, entity);
+}
+
+void RS_EntityContainer::trackNestedSelection(LC_SelectionSet *selectionSet, RS_Entity *entity) {
+    if (!entity->isContainer()) {
+        return;
+    }
+    for (RS_Entity *e: *static_cast<RS_EntityContainer *>(entity)) {
+        if (e->getFlag(RS2::FlagSelected)) {
+            selectionSet->add(e, true);
+        }
+        trackNestedSelection(selectionSet, e);
+    }
+}
+
+/**
+ * Unregisters entity removed from the container and its sub-entities from the selection set.
+ */
+void RS_EntityContainer::untrackSelection(RS_Entity *entity) {
+    if (entity == nullptr) {
+        return;
+    }
+    LC_SelectionSet* selectionSet = findSelectionSet();
+    if (selectionSet != nullptr) {
+        selectionSet->remove(entity);
+        untrackNestedSelection(selectionSet, entity);
+    }
+}
+
+void RS_EntityContainer::untrackNestedSelection(LC_SelectionSet *selectionSet, RS_Entity *entity) {
+    if (selectionSet->getNestedEntities().empty() || !entity->isContainer()) {
+        return;
+    }
+    for (RS_Entity *e: *static_cast<RS_EntityContainer *>(entity)) {
+        selectionSet->remove(e);
+        untrackNestedSelection(selectionSet, e);
+    }
+}
+
 
 /**
  * Adjusts the borders of this graphic (max/min values)
@@ -761,7 +951,81 @@ void RS_EntityContainer::calculateBorders() {
     RS_DEBUG->print("RS_EntityContainer::calculateBorders: size 1: %f,%f",
                     getSize().x, getSize().y);
 
-    // needed for correcting corrupt data (PLANS.dxf)
+    fixCorruptBorders();
+
+    RS_DEBUG->print("RS_EntityContainer::calculateBorders: size: %f,%f",
+                    getSize().x, getSize().y);
+
+    //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
+
+    //printf("borders: %lf/%lf  %lf/%lf\n", minV.x, minV.y, maxV.x, maxV.y);
+    //RS_Entity::calculateBorders();
+}
+
+/**
+ * Rebuilds the borders of this container from the borders its children
+ * already have. Unlike calculateBorders(), children are not recalculated,
+ * only children with invalidated borders refresh themselves on demand.
+ */
+void RS_EntityContainer::refreshBorders() {
+    resetBorders();
+    for (RS_Entity *e: *this) {
+        RS_Layer *layer = e->getLayer();
+        if (e->isVisible() && !(layer && layer->isFrozen())) {
+            adjustBorders(e);
+        }
+    }
+    fixCorruptBorders();
+}
+
+/**
+ * Marks the borders of this container and all its parents as stale.
+ * They are recomputed on the next getMin() / getMax() call.
+ */
+void RS_EntityContainer::invalidateBorders() {
+    for (RS_EntityContainer* c = this; c != nullptr && !c->m_bordersDirty; c = c->getParent()) {
+        c->m_bordersDirty = true;
+    }
+}
+
+/**
+ * Recomputes invalidated borders of this container and of all nested entities, including the ones that are
+ * skipped by calculateBorders() (hidden or on frozen layers), so following traversals only read borders.
+ */
+void RS_EntityContainer::validateBordersDeep() {
+    getMin();
+    for (RS_Entity *e: std::as_const(m_entities)) {
+        if (e->isContainer()) {
+            static_cast<RS_EntityContainer *>(e)->validateBordersDeep();
+        } else {
+            e->getMin();
+        }
+    }
+}
+
+/**
+ * @return true if the entity contributes to the borders of this container
+ * and touches them, so the borders may shrink without it.
+ */
+bool RS_EntityContainer::isBorderEntity(RS_Entity* entity) const {
+    if (entity == nullptr || m_bordersDirty) {
+        return false;
+    }
+    RS_Layer *layer = entity->getLayer();
+    if (!entity->isVisible() || (layer && layer->isFrozen())
+        || (entity->isContainer() && entity->count() == 0)) {
+        return false;
+    }
+    const RS_Vector eMin = entity->getMin();
+    const RS_Vector eMax = entity->getMax();
+    return eMin.x <= minV.x + RS_TOLERANCE || eMin.y <= minV.y + RS_TOLERANCE
+           || eMax.x >= maxV.x - RS_TOLERANCE || eMax.y >= maxV.y - RS_TOLERANCE;
+}
+
+/**
+ * Resets invalid borders to zero, needed for correcting corrupt data (PLANS.dxf).
+ */
+void RS_EntityContainer::fixCorruptBorders() {
     if (minV.x > maxV.x || minV.x > RS_MAXDOUBLE || maxV.x > RS_MAXDOUBLE
         || minV.x < RS_MINDOUBLE || maxV.x < RS_MINDOUBLE) {
         minV.x = 0.0;
@@ -772,14 +1036,6 @@ void RS_EntityContainer::calculateBorders() {
         minV.y = 0.0;
         maxV.y = 0.0;
     }
-
-    RS_DEBUG->print("RS_EntityContainer::calculateBorders: size: %f,%f",
-                    getSize().x, getSize().y);
-
-    //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
-
-    //printf("borders: %lf/%lf  %lf/%lf\n", minV.x, minV.y, maxV.x, maxV.y);
-    //RS_Entity::calculateBorders();
 }
 
 //namespace {
@@ -813,19 +1069,7 @@ void RS_EntityContainer::forcedCalculateBorders() {
         adjustBorders(e);
     }
 
-    // needed for correcting corrupt data (PLANS.dxf)
-    if (minV.x > maxV.x || minV.x > RS_MAXDOUBLE || maxV.x > RS_MAXDOUBLE
-        || minV.x < RS_MINDOUBLE || maxV.x < RS_MINDOUBLE) {
-
-        minV.x = 0.0;
-        maxV.x = 0.0;
-    }
-    if (minV.y > maxV.y || minV.y > RS_MAXDOUBLE || maxV.y > RS_MAXDOUBLE
-        || minV.y < RS_MINDOUBLE || maxV.y < RS_MINDOUBLE) {
-
-        minV.y = 0.0;
-        maxV.y = 0.0;
-    }
+    fixCorruptBorders();
 
     //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
 
@@ -842,21 +1086,60 @@ void RS_EntityContainer::forcedCalculateBorders() {
 void RS_EntityContainer::updateDimensions(bool autoText) {
     RS_DEBUG->print("RS_EntityContainer::updateDimensions()");
 
-    //for (RS_Entity* e=firstEntity(RS2::ResolveNone);
-    //        e;
-    //        e=nextEntity(RS2::ResolveNone)) {
+    std::vector<RS_Dimension*> dimensions;
+    collectDimensions(this, dimensions);
+    if (dimensions.empty()) {
+        return;
+    }
 
-    for (RS_Entity *e: *this) {
-        if (RS_Information::isDimension(e->rtti())) {
-            auto dimension = static_cast<RS_Dimension*>(e);
+    // Dimensions are independent from each other, so they are regenerated in parallel. Everything shared is
+    // prepared here: the resolved dimension style (its resolving may add variables to the graphic) and the fonts
+    // of labels. The style is dropped by the graphic on changes of variables or of the unitless grid setting.
+    std::set<QString> fonts;
+    RS_Graphic* graphic = getGraphic();
+    if (graphic != nullptr) {
+        fonts.insert(graphic->getResolvedDimStyle()->textStyle);
+    }
+    for (RS_Dimension* dimension: dimensions) {
+        collectTextFonts(dimension->getLabel(false), fonts);
+    }
+    for (const QString& font: fonts) {
+        RS_FONTLIST->requestFont(font);
+    }
+
+    if (dimensions.size() < parallelDimensionsThreshold || QThread::idealThreadCount() < 2) {
+        for (RS_Dimension* dimension: dimensions) {
             // update and reposition label:
             dimension->updateDim(autoText);
-        } else if (e->rtti() == RS2::EntityDimLeader)
-            e->update();
-        else if (e->isContainer()) {
-            auto container = static_cast<RS_EntityContainer*>(e);
-            container->updateDimensions(autoText);
         }
+    } else {
+        // Workers write only to the dimension they regenerate. Shared state is only read, and it can't change
+        // meanwhile, as the owning thread takes part in regeneration and returns after all workers are done:
+        // - the resolved style, which is immutable and shared by the graphic under lock;
+        // - variables of the graphic (unit), active layer and pen of the document, assigned to new components;
+        // - the font list and the fonts of labels, loaded above; letters are generated by RS_Font under its lock;
+        // - RS_DEBUG, its level is set on startup and stdio calls lock the log stream.
+        // Borders of containers holding dimensions are invalidated here, as the dimensions change anyway. So
+        // invalidation by workers stops at the dimension and doesn't write to the shared parents.
+        for (RS_Dimension* dimension: dimensions) {
+            RS_EntityContainer* parent = dimension->getParent();
+            if (parent != nullptr) {
+                parent->invalidateBorders();
+            }
+        }
+        std::atomic<size_t> nextDimension{0};
+        auto updateDims = [&dimensions, &nextDimension, autoText] {
+            for (size_t i = nextDimension++; i < dimensions.size(); i = nextDimension++) {
+                dimensions[i]->updateDim(autoText);
+            }
+        };
+        QThreadPool threadPool;
+        // the calling thread updates dimensions too, instead of just waiting for workers
+        for (int i = 1; i < QThread::idealThreadCount(); i++) {
+            threadPool.start(updateDims);
+        }
+        updateDims();
+        threadPool.waitForDone();
     }
 
     RS_DEBUG->print("RS_EntityContainer::updateDimensions() OK");
@@ -1308,10 +1591,12 @@ RS_Entity *RS_EntityContainer::entityAt(int index) {
 
 
 void RS_EntityContainer::setEntityAt(int index, RS_Entity *en) {
+    untrackSelection(m_entities.at(index));
     if (autoDelete && m_entities.at(index)) {
         delete m_entities.at(index);
     }
     m_entities[index] = en;
+    trackSelection(en);
 }
 
 /**
@@ -1869,7 +2154,7 @@ void RS_EntityContainer::move(const RS_Vector &offset) {
         adjustBorders(e);
     }
     if (m_autoUpdateBorders)
-        calculateBorders();
+        refreshBorders();
 }
 
 void RS_EntityContainer::rotate(const RS_Vector &center, double angle) {
@@ -1884,7 +2169,7 @@ void RS_EntityContainer::rotate(const RS_Vector &center, const RS_Vector &angleV
         adjustBorders(e);
     }
     if (m_autoUpdateBorders)
-        calculateBorders();
+        refreshBorders();
 }
 
 void RS_EntityContainer::scale(const RS_Vector &center, const RS_Vector &factor) {
@@ -1895,7 +2180,7 @@ void RS_EntityContainer::scale(const RS_Vector &center, const RS_Vector &factor)
             adjustBorders(e);
         }
         if (m_autoUpdateBorders)
-            calculateBorders();
+            refreshBorders();
     }
 }
 
@@ -31,6 +31,8 @@
 #include <QList>
 #include "rs_entity.h"
 
+class LC_SelectionSet;
+
 /**
  * Class representing a tree of entities.
  * Typical entity containers are graphics, polylines, groups, texts, ...)
@@ -147,6 +149,13 @@ public:
     virtual void collectSelected(std::vector<RS_Entity*> &collect, bool deep, QList<RS2::EntityType> const &types = {});
     virtual double totalSelectedLength();
     LC_SelectionInfo getSelectionInfo(/*bool deep, */QList<RS2::EntityType> const& types = {});
+    /**
+     * @return selection set that tracks selected entities of this container, or nullptr if
+     * selection tracking is not enabled for the container (it is enabled for documents only).
+     */
+    LC_SelectionSet* getSelectionSet() const {
+        return m_selectionSet.get();
+    }
 
     /**
      * Enables / disables automatic update of borders on entity removals
@@ -161,6 +170,8 @@ public:
     virtual void adjustBorders(RS_Entity* entity);
     void calculateBorders() override;
     void forcedCalculateBorders();
+    void invalidateBorders();
+    void validateBordersDeep();
     void updateDimensions( bool autoText=true);
     virtual void updateInserts();
     virtual void updateSplines();
@@ -249,11 +260,14 @@ public:
 
     void push_back(RS_Entity* entity) {
         m_entities.push_back(entity);
+        trackSelection(entity);
     }
     void pop_back()
     {
-        if (!isEmpty())
+        if (!isEmpty()) {
+            untrackSelection(m_entities.last());
             m_entities.pop_back();
+        }
     }
 
 /**
@@ -282,6 +296,7 @@ public:
     RS_Entity *cloneProxy() const override;
 
 protected:
+    void refreshBorders() override;
     /**
      * @brief getLoops for hatch, split closed loops into single simple loops. All returned containers are owned by
      * the returned object.
@@ -294,6 +309,8 @@ protected:
     /** sub container used only temporarily for iteration. */
     mutable RS_EntityContainer* subContainer = nullptr;
 
+    void enableSelectionTracking();
+
 
 private:
 /**
@@ -301,6 +318,8 @@ private:
  * @return true when entity of this container won't be considered for snapping points
  */
     bool ignoredSnap() const;
+    bool isBorderEntity(RS_Entity* entity) const;
+    void fixCorruptBorders();
 
     /** m_entities in the container */
     QList<RS_Entity *> m_entities;
@@ -311,6 +330,14 @@ private:
     bool m_autoUpdateBorders = true;
     mutable int entIdx = 0;
     bool autoDelete = false;
+    /** incrementally maintained set of selected entities, used by documents */
+    std::unique_ptr<LC_SelectionSet> m_selectionSet;
+
+    LC_SelectionSet* findSelectionSet() const;
+    void trackSelection(RS_Entity* entity);
+    void trackNestedSelection(LC_SelectionSet* selectionSet, RS_Entity* entity);
+    void untrackSelection(RS_Entity* entity);
+    void untrackNestedSelection(LC_SelectionSet* selectionSet, RS_Entity* entity);
 
 
 };
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_resolveddimstyle.h"
+
+#include "rs_filterdxfrw.h"
+#include "rs_graphic.h"
+#include "rs_math.h"
+#include "rs_settings.h"
+#include "rs_units.h"
+
+namespace {
+    /**
+     * @return the given length variable, or the default value given in mm converted to the graphic unit.
+     * If the variable is not found it is added with the converted default value.
+     */
+    double resolveLength(RS_Graphic* graphic, const QString& key, double defMM) {
+        double v = graphic->getVariableDouble(key, RS_MINDOUBLE);
+        if (v <= RS_MINDOUBLE) {
+            graphic->addVariable(key, RS_Units::convert(defMM, RS2::Millimeter, graphic->getUnit()), 40);
+            v = graphic->getVariableDouble(key, 1.0);
+        }
+        return v;
+    }
+}
+
+std::shared_ptr<const LC_ResolvedDimStyle> LC_ResolvedDimStyle::create(RS_Graphic* graphic) {
+    auto style = std::make_shared<LC_ResolvedDimStyle>();
+    if (graphic == nullptr) {
+        // dimensions without a graphic are previews, created on the GUI thread
+        style->unitlessGrid = LC_GET_ONE_BOOL("Appearance", "UnitlessGrid", true);
+        return style;
+    }
+
+    style->unitlessGrid = graphic->isUnitlessGrid();
+
+    style->generalFactor = resolveLength(graphic, "$DIMLFAC", 1.0);
+    style->generalScale = resolveLength(graphic, "$DIMSCALE", 1.0);
+    style->arrowSize = resolveLength(graphic, "$DIMASZ", 2.5);
+    style->tickSize = resolveLength(graphic, "$DIMTSZ", 0.);
+    style->extensionLineExtension = resolveLength(graphic, "$DIMEXE", 1.25);
+    style->extensionLineOffset = resolveLength(graphic, "$DIMEXO", 0.625);
+    style->dimensionLineGap = resolveLength(graphic, "$DIMGAP", 0.625);
+    style->textHeight = resolveLength(graphic, "$DIMTXT", 2.5);
+    style->fixedLength = resolveLength(graphic, "$DIMFXL", 1.0);
+
+    style->insideHorizontalText = graphic->getVariableInt("$DIMTIH", 1) > 0;
+    if (style->insideHorizontalText) {
+        graphic->addVariable("$DIMTIH", 1, 70);
+    }
+    style->fixedLengthOn = graphic->getVariableInt("$DIMFXLON", 0) == 1;
+    if (style->fixedLengthOn) {
+        graphic->addVariable("$DIMFXLON", 1, 70);
+    }
+
+    style->extensionLineWidth = RS2::intToLineWidth(graphic->getVariableInt("$DIMLWE", -2));
+    style->dimensionLineWidth = RS2::intToLineWidth(graphic->getVariableInt("$DIMLWD", -2));
+    style->dimensionLineColor = RS_FilterDXFRW::numberToColor(graphic->getVariableInt("$DIMCLRD", 0));
+    style->extensionLineColor = RS_FilterDXFRW::numberToColor(graphic->getVariableInt("$DIMCLRE", 0));
+    style->textColor = RS_FilterDXFRW::numberToColor(graphic->getVariableInt("$DIMCLRT", 0));
+    style->textStyle = graphic->getVariableString("$DIMTXSTY", "standard");
+    style->linearFormat = graphic->getVariableInt("$DIMLUNIT", 2);
+    style->decimalPlaces = graphic->getVariableInt("$DIMDEC", 4);
+    style->zerosSuppression = graphic->getVariableInt("$DIMZIN", 1);
+    style->decimalSeparator = graphic->getVariableInt("$DIMDSEP", 0);
+    style->angularFormat = graphic->getVariableInt("$DIMAUNIT", 0);
+    style->angularDecimalPlaces = graphic->getVariableInt("$DIMADEC", 0);
+    style->angularZerosSuppression = graphic->getVariableInt("$DIMAZIN", 0);
+    return style;
+}
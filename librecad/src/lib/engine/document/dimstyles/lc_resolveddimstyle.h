@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_RESOLVEDDIMSTYLE_H
+#define LC_RESOLVEDDIMSTYLE_H
+
+#include <memory>
+
+#include <QString>
+
+#include "rs.h"
+#include "rs_color.h"
+
+class RS_Graphic;
+
+/**
+ * Dimension style values resolved from the drawing header variables.
+ *
+ * Dimensions read these values many times during regeneration, looking them up in the variables dictionary for
+ * each access was a noticeable cost for drawings with many dimensions. The snapshot is built once by RS_Graphic
+ * and shared by all dimensions until a variable changes. It is immutable, so dimensions may be regenerated from
+ * worker threads.
+ */
+struct LC_ResolvedDimStyle {
+    double generalFactor = 1.0;    // $DIMLFAC
+    double generalScale = 1.0;     // $DIMSCALE
+    double arrowSize = 1.0;        // $DIMASZ
+    double tickSize = 1.0;         // $DIMTSZ
+    double extensionLineExtension = 1.0; // $DIMEXE
+    double extensionLineOffset = 1.0;    // $DIMEXO
+    double dimensionLineGap = 1.0; // $DIMGAP
+    double textHeight = 1.0;       // $DIMTXT
+    bool insideHorizontalText = true; // $DIMTIH
+    bool fixedLengthOn = false;    // $DIMFXLON
+    double fixedLength = 1.0;      // $DIMFXL
+    RS2::LineWidth extensionLineWidth = RS2::WidthByBlock; // $DIMLWE
+    RS2::LineWidth dimensionLineWidth = RS2::WidthByBlock; // $DIMLWD
+    RS_Color dimensionLineColor;   // $DIMCLRD
+    RS_Color extensionLineColor;   // $DIMCLRE
+    RS_Color textColor;            // $DIMCLRT
+    QString textStyle = "standard"; // $DIMTXSTY
+    int linearFormat = 2;          // $DIMLUNIT
+    int decimalPlaces = 4;         // $DIMDEC
+    int zerosSuppression = 1;      // $DIMZIN
+    int decimalSeparator = 0;      // $DIMDSEP
+    int angularFormat = 0;         // $DIMAUNIT
+    int angularDecimalPlaces = 0;  // $DIMADEC
+    int angularZerosSuppression = 0; // $DIMAZIN
+    // "Appearance/UnitlessGrid" application setting, as captured by the graphic
+    bool unitlessGrid = true;
+
+    /**
+     * Resolves the style of the given graphic. As dimensions did before, missing length variables are added to the
+     * graphic with default values converted from millimeters to the drawing unit. Without a graphic lengths are 1.0.
+     */
+    static std::shared_ptr<const LC_ResolvedDimStyle> create(RS_Graphic* graphic);
+};
+
+#endif // LC_RESOLVEDDIMSTYLE_H
@@ -94,9 +94,9 @@ QString LC_DimArc::getMeasuredLabel() {
     QString measuredLabel;
 
     if (currentGraphic) {
-        const int dimlunit{getGraphicVariableInt(QStringLiteral("$DIMLUNIT"), 2)};
-        const int dimdec{getGraphicVariableInt(QStringLiteral("$DIMDEC"), 4)};
-        const int dimzin{getGraphicVariableInt(QStringLiteral("$DIMZIN"), 1)};
+        const int dimlunit{getDimLinearFormat()};
+        const int dimdec{getDimDecimalPlaces()};
+        const int dimzin{getDimTrailingZerosSuppressionMode()};
 
         RS2::LinearFormat format = currentGraphic->convertLinearFormatDXF2LC(dimlunit);
 
@@ -105,7 +105,7 @@ QString LC_DimArc::getMeasuredLabel() {
         if (format == RS2::Decimal) measuredLabel = stripZerosLinear(measuredLabel, dimzin);
 
         if ((format == RS2::Decimal) || (format == RS2::ArchitecturalMetric)) {
-            if (getGraphicVariableInt("$DIMDSEP", 0) == 44) measuredLabel.replace(QChar('.'), QChar(','));
+            if (getDimDecimalFormatSeparatorChar() == 44) measuredLabel.replace(QChar('.'), QChar(','));
         }
     }
     else {
@@ -144,9 +144,9 @@ RS_Entity* RS_DimAngular::clone() const
  */
 QString RS_DimAngular::getMeasuredLabel()
 {
-    int dimaunit {getGraphicVariableInt( QStringLiteral( "$DIMAUNIT"), 0)};
-    int dimadec {getGraphicVariableInt( QStringLiteral( "$DIMADEC"), 0)};
-    int dimazin {getGraphicVariableInt( QStringLiteral( "$DIMAZIN"), 0)};
+    int dimaunit {getDimAngularFormat()};
+    int dimadec {getDimAngularDecimalPlaces()};
+    int dimazin {getDimAngularZerosSuppressionMode()};
     RS2::AngleFormat format {RS_Units::numberToAngleFormat( dimaunit)};
     QString strLabel( RS_Units::formatAngle( dimAngle, format, dimadec));
 
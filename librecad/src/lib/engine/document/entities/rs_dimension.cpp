@@ -28,14 +28,13 @@
 
 #include <QRegularExpression>
 
-#include "muParser.h"
+#include "lc_resolveddimstyle.h"
 #include "rs_arc.h"
-#include "rs_filterdxfrw.h"
+#include "rs_graphic.h"
 #include "rs_information.h"
 #include "rs_line.h"
 #include "rs_math.h"
 #include "rs_pen.h"
-#include "rs_settings.h"
 #include "rs_solid.h"
 #include "rs_units.h"
 
@@ -52,23 +51,9 @@ namespace
         QString expr = expression.mid(1, expression.size() - 2);
         const QString variable("a");
         expr.replace("<>", variable);
-        try {
-            mu::Parser p;
-
-#ifdef _UNICODE
-            p.DefineVar(variable.toStdWString(), &dimValue);
-            p.SetExpr(expr.toStdWString());
-#else
-        p.DefineVar(variable.toStdString(), &dimValue);
-        p.SetExpr(expr.toStdString());
-#endif
-
-            double functionValue = p.Eval();
-            return QString::number(functionValue);
-        }
-        catch (...) {
-            return expression;
-        }
+        bool ok = false;
+        double functionValue = RS_Math::eval(expr, {{variable, dimValue}}, &ok);
+        return ok ? QString::number(functionValue) : expression;
     }
 
     /**
@@ -656,151 +641,160 @@ void RS_Dimension::createDimensionLine(const RS_Vector& dimLineStart, const RS_V
     }
 }
 
+/**
+ * @return dimension style resolved from the variables of the graphic. Dimensions outside of a graphic
+ * (e.g. previews) resolve to the defaults.
+ */
+std::shared_ptr<const LC_ResolvedDimStyle> RS_Dimension::getResolvedDimStyle() const {
+    RS_Graphic* graphic = getGraphic();
+    return graphic != nullptr ? graphic->getResolvedDimStyle() : LC_ResolvedDimStyle::create(nullptr);
+}
+
 /**
  * @return general factor for linear dimensions. $DIMLFAC
  */
 double RS_Dimension::getGeneralFactor() {
-    return getGraphicVariable("$DIMLFAC", 1.0, 40);
+    return getResolvedDimStyle()->generalFactor;
 }
 
 /**
  * @return General scale for dimensions (DIMSCALE)
  */
 double RS_Dimension::getGeneralScale() {
-    return getGraphicVariable("$DIMSCALE", 1.0, 40);
+    return getResolvedDimStyle()->generalScale;
 }
 
 /**
  * @return arrow size in drawing units - $DIMASZ
  */
 double RS_Dimension::getArrowSize() {
-    return getGraphicVariable("$DIMASZ", 2.5, 40);
+    return getResolvedDimStyle()->arrowSize;
 }
 
 /**
  * @return tick size in drawing units - $DIMTSZ
  */
 double RS_Dimension::getTickSize() {
-    return getGraphicVariable("$DIMTSZ", 0., 40);
+    return getResolvedDimStyle()->tickSize;
 }
 
 /**
  * @return extension line overlength in drawing units. definition line definition (DIMEXE)
  */
 double RS_Dimension::getExtensionLineExtension() {
-    return getGraphicVariable("$DIMEXE", 1.25, 40);
+    return getResolvedDimStyle()->extensionLineExtension;
 }
 
 /**
  * @return extension line offset from entities in drawing units. // distance from entities (DIMEXO)
  */
 double RS_Dimension::getExtensionLineOffset() {
-    return getGraphicVariable("$DIMEXO", 0.625, 40);
+    return getResolvedDimStyle()->extensionLineOffset;
 }
 
 /**
  * @return extension line gap to text in drawing units. // text distance to line (DIMGAP)
  */
 double RS_Dimension::getDimensionLineGap() {
-    return getGraphicVariable("$DIMGAP", 0.625, 40);
+    return getResolvedDimStyle()->dimensionLineGap;
 }
 
 /**
  * @return Dimension labels text height. // text height (DIMTXT)
  */
 double RS_Dimension::getTextHeight() {
-    return getGraphicVariable("$DIMTXT", 2.5, 40);
+    return getResolvedDimStyle()->textHeight;
 }
 
 /**
  * @return Dimension labels alignment text true= horizontal, false= aligned. - $DIMTIH
  */
 bool RS_Dimension::getInsideHorizontalText() {
-    int v = getGraphicVariableInt("$DIMTIH", 1);
-    if (v > 0) {
-        addGraphicVariable("$DIMTIH", 1, 70);
-        getGraphicVariableInt("$DIMTIH", 1);
-        return true;
-    }
-    return false;
+    return getResolvedDimStyle()->insideHorizontalText;
 }
 
 /**
  * @return Dimension fixed length for extension lines true= fixed, false= not fixed - $DIMFXLON
  */
 bool RS_Dimension::getFixedLengthOn() {
-    int v = getGraphicVariableInt("$DIMFXLON", 0);
-    if (v == 1) {
-        addGraphicVariable("$DIMFXLON", 1, 70);
-        getGraphicVariableInt("$DIMFXLON", 0);
-        return true;
-    }
-    return false;
+    return getResolvedDimStyle()->fixedLengthOn;
 }
 
 /**
  * @return Dimension fixed length for extension lines.
  */
 double RS_Dimension::getFixedLength() {
-    return getGraphicVariable("$DIMFXL", 1.0, 40);
+    return getResolvedDimStyle()->fixedLength;
 }
 
 /**
  * @return extension line Width.
  */
 RS2::LineWidth RS_Dimension::getExtensionLineWidth() {
-    return RS2::intToLineWidth(getGraphicVariableInt("$DIMLWE", -2)); //default -2 (RS2::WidthByBlock)
+    return getResolvedDimStyle()->extensionLineWidth;
 }
 
 /**
  * @return dimension line Width.
  */
 RS2::LineWidth RS_Dimension::getDimensionLineWidth() {
-    return RS2::intToLineWidth(getGraphicVariableInt("$DIMLWD", -2)); //default -2 (RS2::WidthByBlock)
+    return getResolvedDimStyle()->dimensionLineWidth;
 }
 
 /**
  * @return dimension line Color.
  */
 RS_Color RS_Dimension::getDimensionLineColor() {
-    return RS_FilterDXFRW::numberToColor(getGraphicVariableInt("$DIMCLRD", 0));
+    return getResolvedDimStyle()->dimensionLineColor;
 }
 
 /**
  * @return extension line Color.
  */
 RS_Color RS_Dimension::getExtensionLineColor() {
-    return RS_FilterDXFRW::numberToColor(getGraphicVariableInt("$DIMCLRE", 0));
+    return getResolvedDimStyle()->extensionLineColor;
 }
 
 /**
  * @return dimension text Color.
  */
 RS_Color RS_Dimension::getTextColor() {
-    return RS_FilterDXFRW::numberToColor(getGraphicVariableInt("$DIMCLRT", 0));
+    return getResolvedDimStyle()->textColor;
 }
 
 /**
  * @return text style for dimensions.
  */
 QString RS_Dimension::getTextStyle() {
-    return getGraphicVariableString("$DIMTXSTY", "standard");
+    return getResolvedDimStyle()->textStyle;
 }
 
 int RS_Dimension::getDimLinearFormat() {
-    return getGraphicVariableInt("$DIMLUNIT", 2);
+    return getResolvedDimStyle()->linearFormat;
 }
 
 int RS_Dimension::getDimDecimalPlaces() {
-    return getGraphicVariableInt("$DIMDEC", 4);
+    return getResolvedDimStyle()->decimalPlaces;
 }
 
 int RS_Dimension::getDimTrailingZerosSuppressionMode() {
-    return getGraphicVariableInt("$DIMZIN", 1);
+    return getResolvedDimStyle()->zerosSuppression;
 }
 
 int RS_Dimension::getDimDecimalFormatSeparatorChar() {
-    return getGraphicVariableInt(QStringLiteral("$DIMDSEP"), 0);
+    return getResolvedDimStyle()->decimalSeparator;
+}
+
+int RS_Dimension::getDimAngularFormat() {
+    return getResolvedDimStyle()->angularFormat;
+}
+
+int RS_Dimension::getDimAngularDecimalPlaces() {
+    return getResolvedDimStyle()->angularDecimalPlaces;
+}
+
+int RS_Dimension::getDimAngularZerosSuppressionMode() {
+    return getResolvedDimStyle()->angularZerosSuppression;
 }
 
 /**
@@ -1005,8 +999,9 @@ QString RS_Dimension::createLinearMeasuredLabel(double dist) {
 
 
 double RS_Dimension::prepareLabelLinearDistance(double distance) {
-    double dist = distance  * getGeneralFactor();
-    if (!LC_GET_ONE_BOOL("Appearance", "UnitlessGrid", true)) {
+    auto style = getResolvedDimStyle();
+    double dist = distance  * style->generalFactor;
+    if (!style->unitlessGrid) {
         dist = RS_Units::convert(dist);
     }
     return dist;
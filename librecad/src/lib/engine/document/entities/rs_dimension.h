@@ -28,10 +28,13 @@
 #ifndef RS_DIMENSION_H
 #define RS_DIMENSION_H
 
+#include <memory>
+
 #include "rs_entitycontainer.h"
 #include "rs_mtext.h"
 
 struct RS_ArcData;
+struct LC_ResolvedDimStyle;
 class RS_Arc;
 class RS_Color;
 class RS_Line;
@@ -171,6 +174,10 @@ public:
     int getDimDecimalPlaces();
     int getDimTrailingZerosSuppressionMode();
     int getDimDecimalFormatSeparatorChar();
+    int getDimAngularFormat();
+    int getDimAngularDecimalPlaces();
+    int getDimAngularZerosSuppressionMode();
+    std::shared_ptr<const LC_ResolvedDimStyle> getResolvedDimStyle() const;
 
     double getGraphicVariable(const QString& key, double defMM, int code);
     static QString stripZerosAngle(QString angle, int zeros=0);
@@ -26,6 +26,7 @@
 **********************************************************************/
 
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <utility>
@@ -50,6 +51,7 @@
 #include "rs_text.h"
 #include "rs_vector.h"
 #include "lc_quadratic.h"
+#include "lc_selectionset.h"
 
 
 struct RS_Entity::Impl {
@@ -83,6 +85,7 @@ RS_Entity::RS_Entity(const RS_Entity& other):
     , maxV {other.maxV}
     , m_layer {other.m_layer}
     , updateEnabled {other.updateEnabled}
+    , m_bordersDirty {other.m_bordersDirty}
     , m_pImpl{std::make_unique<Impl>(*other.m_pImpl)}
 {
     init();
@@ -95,6 +98,7 @@ RS_Entity& RS_Entity::operator = (const RS_Entity& other)
     maxV  = other.maxV;
     m_layer  = other.m_layer;
     updateEnabled = other.updateEnabled;
+    m_bordersDirty = other.m_bordersDirty;
     m_pImpl->fromOther(other.m_pImpl.get());
     init();
     return *this;
@@ -106,6 +110,7 @@ RS_Entity::RS_Entity(RS_Entity&& other):
     , maxV {other.maxV}
     , m_layer {other.m_layer}
     , updateEnabled {other.updateEnabled}
+    , m_bordersDirty {other.m_bordersDirty}
     , m_pImpl{std::move(other.m_pImpl)}
 {
     init();
@@ -118,12 +123,17 @@ RS_Entity& RS_Entity::operator = (RS_Entity&& other)
     maxV  = other.maxV;
     m_layer  = other.m_layer;
     updateEnabled = other.updateEnabled;
+    m_bordersDirty = other.m_bordersDirty;
     m_pImpl = std::move(other.m_pImpl);
     init();
     return *this;
 }
 
-RS_Entity::~RS_Entity() = default;
+RS_Entity::~RS_Entity() {
+    if (m_selectionSet != nullptr) {
+        m_selectionSet->remove(this);
+    }
+}
 
 /**
  * Copy constructor.
@@ -161,7 +171,8 @@ void RS_Entity::init() {
  * Gives this entity a new unique m_id.
  */
 void RS_Entity::initId() {
-    static unsigned long long idCounter=0;
+    // atomic, entities may be created by dimension regeneration running in worker threads
+    static std::atomic<unsigned long long> idCounter{0};
     m_id = ++idCounter;
 }
 
@@ -179,6 +190,17 @@ void RS_Entity::resetBorders() {
 
     minV.set(maxd, maxd);
     maxV.set(mind, mind);
+    m_bordersDirty = false;
+}
+
+/**
+ * Recomputes borders that were invalidated. Called from getMin() and
+ * getMax(), so borders are only computed when they're actually needed.
+ */
+void RS_Entity::validateBorders() const {
+    auto* self = const_cast<RS_Entity*>(this);
+    self->m_bordersDirty = false;
+    self->refreshBorders();
 }
 
 
@@ -208,10 +230,30 @@ bool RS_Entity::setSelected(bool select) {
     } else {
         delFlag(RS2::FlagSelected);
     }
+    updateSelectionSet(select);
 
     return true;
 }
 
+/**
+ * Registers (or unregisters) this entity in the selection set of the nearest
+ * document, so the document may answer selection queries without traversal of all entities.
+ */
+void RS_Entity::updateSelectionSet(bool select) {
+    if (select) {
+        for (RS_EntityContainer* c = parent; m_selectionSet == nullptr && c != nullptr; c = c->getParent()) {
+            LC_SelectionSet* selectionSet = c->getSelectionSet();
+            if (selectionSet != nullptr) {
+                selectionSet->add(this, c != parent);
+            } else if (c->isDocument()) {
+                break;
+            }
+        }
+    } else if (m_selectionSet != nullptr) {
+        m_selectionSet->remove(this);
+    }
+}
+
 /**
  * Toggles select on this entity.
  */
@@ -480,7 +522,7 @@ bool RS_Entity::isHighlighted() const{
 }
 
 RS_Vector RS_Entity::getSize() const {
-	return maxV-minV;
+	return getMax()-getMin();
 }
 
 /**
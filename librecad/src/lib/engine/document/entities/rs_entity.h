@@ -43,6 +43,7 @@ class RS_Block;
 class RS_Graphic;
 class RS_EntityContainer;
 class LC_Quadratic;
+class LC_SelectionSet;
 
 /**
  * Base class for an entity (line, arc, circle, ...)
@@ -204,20 +205,28 @@ public:
     }
 
     /**
-     * This method doesn't do any calculations.
+     * This method doesn't do any calculations unless the borders were
+     * invalidated since they were last computed.
      * @return minimum coordinate of the entity.
      * @see calculateBorders()
      */
     RS_Vector getMin() const{
+        if (m_bordersDirty) {
+            validateBorders();
+        }
         return minV;
     }
 
     /**
-     * This method doesn't do any calculations.
-     * @return minimum coordinate of the entity.
+     * This method doesn't do any calculations unless the borders were
+     * invalidated since they were last computed.
+     * @return maximum coordinate of the entity.
      * @see calculateBorders()
      */
     RS_Vector getMax() const{
+        if (m_bordersDirty) {
+            validateBorders();
+        }
         return maxV;
     }
 
@@ -596,10 +605,28 @@ protected:
     RS_Layer *m_layer = nullptr;
     //! auto updating enabled?
     bool updateEnabled = false;
+    //! borders are stale and get recomputed by refreshBorders() on the next getMin()/getMax()
+    bool m_bordersDirty = false;
+
+    /**
+     * Recomputes stale borders on demand. Containers override this to rebuild
+     * their borders from the borders their children already have.
+     */
+    virtual void refreshBorders() {
+        calculateBorders();
+    }
 
 private:
+    friend class LC_SelectionSet;
+
+    void validateBorders() const;
+
+    void updateSelectionSet(bool select);
+
     //! Entity m_id
     unsigned long long m_id = 0;
+    //! selection set of the document that tracks this entity as selected, if any
+    LC_SelectionSet* m_selectionSet = nullptr;
     // pImp to delay pulling in Qt headers
     struct Impl;
     std::unique_ptr<Impl> m_pImpl;
@@ -25,11 +25,13 @@
 **********************************************************************/
 
 #include <iostream>
+#include <memory>
 #include <set>
 
 #include <QPainterPath>
 
 #include "lc_looputils.h"
+#include "lc_profiler.h"
 #include "rs_arc.h"
 #include "rs_circle.h"
 #include "rs_debug.h"
@@ -181,6 +183,15 @@ void RS_Hatch::calculateBorders() {
     activateContour(false);
 }
 
+/**
+ * Rebuilds the borders of this hatch from its contour and pattern.
+ */
+void RS_Hatch::refreshBorders() {
+    activateContour(true);
+    RS_EntityContainer::refreshBorders();
+    activateContour(false);
+}
+
 /**
  * Updates the Hatch. Called when the
  * hatch or it's data, position, alignment, .. changes.
@@ -188,6 +199,7 @@ void RS_Hatch::calculateBorders() {
  * Refill hatch with pattern. Move, scale, rotate, trim, etc.
  */
 void RS_Hatch::update() {
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionRegeneration, RS2::EntityHatch);
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update");
 
@@ -205,6 +217,8 @@ void RS_Hatch::update() {
     if (data.solid==true) {
         RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: processing solid hatch");
         calculateBorders();
+        // loops are ordered again on the next drawing
+        std::atomic_store(&m_orderedLoops, std::shared_ptr<RS_EntityContainer>{});
         return;
     }
 
@@ -234,41 +248,29 @@ void RS_Hatch::update() {
         return;
     }
 
-    // search for pattern
+    // search for pattern, it's shared by all hatches and must not be modified
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: requesting pattern");
-    std::unique_ptr<RS_Pattern> pat = RS_PATTERNLIST->requestPattern(data.pattern);
+    std::shared_ptr<const RS_Pattern> pat = RS_PATTERNLIST->requestPattern(data.pattern);
     if (pat == nullptr) {
         updateRunning = false;
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::update: requesting pattern: %s not found", data.pattern.toUtf8().constData());
         updateError = HATCH_PATTERN_NOT_FOUND;
         return;
-    } else {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: requesting pattern: OK");
-        // make a working copy of hatch pattern
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: cloning pattern");
-        pat.reset((RS_Pattern*)pat->clone());
-        if (pat != nullptr) {
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: cloning pattern: OK");
-        } else {
-            RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::update: error while cloning hatch pattern");
-            return;
-        }
     }
+    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: requesting pattern: OK");
 
-    // scale pattern
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: scaling pattern");
-    pat->scale(RS_Vector(0.0,0.0), RS_Vector(data.scale, data.scale));
-    pat->calculateBorders();
+    // the pattern tile starts at the origin, scaling keeps one of its corners there
+    const RS_Vector scaleFactor{data.scale, data.scale};
+    const RS_Vector tileSize = pat->getSize();
+    RS_Vector pSize{std::abs(data.scale) * tileSize.x, std::abs(data.scale) * tileSize.y};
+    RS_Vector tileOffset{std::max(0., -data.scale * tileSize.x), std::max(0., -data.scale * tileSize.y)};
     forcedCalculateBorders();
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: scaling pattern: OK");
 
     std::unique_ptr<RS_Hatch> copy {(RS_Hatch*)this->clone()};
     copy->rotate(RS_Vector(0.0,0.0), -data.angle);
     copy->forcedCalculateBorders();
 
     // create a pattern over the whole contour.
-    RS_Vector pSize = pat->getSize();
-    RS_Vector rot_center=pat->getMin();
 //    RS_Vector cPos = getMin();
     RS_Vector cSize = getSize();
 
@@ -300,17 +302,25 @@ void RS_Hatch::update() {
     int py2 = (int)ceil(copy->getMax().y/pSize.y);
     RS_Vector dvx=RS_Vector(data.angle)*pSize.x;
     RS_Vector dvy=RS_Vector(data.angle+M_PI*0.5)*pSize.y;
-    pat->rotate(rot_center, data.angle);
-    pat->move(-rot_center);
+    const RS_Vector angleVector{data.angle};
+    const bool scaled = std::abs(data.scale - 1.) > RS_TOLERANCE;
+    const bool rotated = std::abs(data.angle) > RS_TOLERANCE_ANGLE;
 
     RS_EntityContainer tmp;   // container for untrimmed lines
 
-    // adding array of patterns to tmp:
+    // adding array of patterns to tmp, the shared tile is transformed in clones only:
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: creating pattern carpet");
     for (int px=px1; px<px2; px++) {
         for (int py=py1; py<py2; py++) {
-            for(auto e: *pat){
+            for(const RS_Entity* e: *pat){
                 RS_Entity* te=e->clone();
+                if (scaled) {
+                    te->scale(RS_Vector(0.0, 0.0), scaleFactor);
+                    te->move(tileOffset);
+                }
+                if (rotated) {
+                    te->rotate(RS_Vector(0.0, 0.0), angleVector);
+                }
                 te->move(dvx*px + dvy*py);
                 tmp.addEntity(te);
             }
@@ -376,7 +386,8 @@ void RS_Hatch::update() {
     addEntity(hatch);
     //getGraphic()->addEntity(rubbish);
 
-    forcedCalculateBorders();
+    // the contour borders are up to date, only the pattern is new
+    adjustBorders(hatch);
 
     // deactivate contour:
     activateContour(false);
@@ -580,19 +591,26 @@ void RS_Hatch::draw(RS_Painter* painter) {
 
 void RS_Hatch::drawSolidFill(RS_Painter *painter) {//area of solid fill. Use polygon approximation, except trivial cases
 
-    if (needOptimization == true) {
+    // the fill may be drawn by several tile rendering threads at once. Each of them may order loops, as the
+    // optimizer only reads the hatch, and the first published result is kept by the others
+    std::shared_ptr<RS_EntityContainer> orderedLoops = std::atomic_load(&m_orderedLoops);
+    if (orderedLoops == nullptr) {
         LC_LoopUtils::LoopOptimizer optimizer{*this};
-        m_orderedLoops = optimizer.GetResults();
-        needOptimization = false;
+        std::shared_ptr<RS_EntityContainer> optimized = optimizer.GetResults();
+        if (optimized == nullptr) {
+            return;
+        }
+        if (!std::atomic_compare_exchange_strong(&m_orderedLoops, &orderedLoops, optimized)) {
+            // orderedLoops holds the result of another thread now
+            optimized = orderedLoops;
+        }
+        orderedLoops = std::move(optimized);
     }
 
-    if (m_orderedLoops == nullptr)
-        return;
-
     const QBrush brush(painter->brush());
     const RS_Pen pen=painter->getPen();
     try {
-        QPainterPath path = createSolidFillPath(painter);
+        QPainterPath path = painter->createSolidFillPath(*orderedLoops);
         QBrush fillBrush = brush;
         fillBrush.setColor(pen.getColor());
         fillBrush.setStyle(Qt::SolidPattern);
@@ -605,11 +623,6 @@ void RS_Hatch::drawSolidFill(RS_Painter *painter) {//area of solid fill. Use pol
     painter->setPen(pen);
 }
 
-QPainterPath RS_Hatch::createSolidFillPath(RS_Painter *painter) const
-{
-    return painter->createSolidFillPath(*m_orderedLoops);
-}
-
 void RS_Hatch::debugOutPath(const QPainterPath &tmpPath) const {
     int c = tmpPath.elementCount();
     for (int i = 0; i < c; i++){
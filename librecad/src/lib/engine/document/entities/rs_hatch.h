@@ -162,6 +162,9 @@ public:
 
     friend std::ostream& operator << (std::ostream& os, const RS_Hatch& p);
 
+protected:
+    void refreshBorders() override;
+
 private:
     double getTotalAreaImpl() const;
     RS_EntityContainer trimPattern(const RS_EntityContainer& patternEntities) const;
@@ -170,15 +173,13 @@ private:
 
     void debugOutPath(const QPainterPath &tmpPath) const;
 
-    QPainterPath createSolidFillPath( RS_Painter *painter) const;
-
     RS_HatchData data;
     RS_EntityContainer* hatch = nullptr;
     mutable double m_area = RS_MAXDOUBLE;
     RS_HatchError updateError = HATCH_UNDEFINED;
     bool updateRunning = false;
-    bool needOptimization = true;
     bool m_updated=false;
+    // ordered loops of the solid fill, built by the first drawing after update(). Accessed atomically.
     std::shared_ptr<RS_EntityContainer> m_orderedLoops;
 };
 
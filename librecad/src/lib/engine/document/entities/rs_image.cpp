@@ -28,6 +28,7 @@
 #include <QDir>
 #include <QFileInfo>
 
+#include "lc_imagecache.h"
 #include "qc_applicationwindow.h"
 #include "rs_debug.h"
 #include "rs_entitycontainer.h"
@@ -128,10 +129,10 @@ void RS_Image::update() {
     // the whole image:
     QString filePathName = imageRelativePathName(data.file);
 
-    //QImage image = QImage(data.file);
-    img = std::make_shared<QImage>(filePathName);
-    if (!img->isNull()) {
-        data.size = RS_Vector(img->width(), img->height());
+    // decoded images are shared by all entities referring to the same file
+    img = LC_IMAGECACHE->acquire(filePathName);
+    if (img != nullptr) {
+        data.size = RS_Vector(img->getSize().width(), img->getSize().height());
         RS_Image::calculateBorders(); // image update need this.
     } else {
         LC_LOG(RS_Debug::D_ERROR)<<"RS_Image::"<<__func__<<"(): image file not found: "<<data.file<<"("<<filePathName<<")";
@@ -369,7 +370,7 @@ void RS_Image::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
 }
 
 void RS_Image::draw(RS_Painter* painter) {
-    if (!img.get() || img->isNull()) {
+    if (img == nullptr || img->isNull()) {
         return;
     }
     painter->drawImgWCS(*img, data.insertionPoint, data.uVector, data.vVector);
@@ -28,6 +28,7 @@
 
 #include<iostream>
 
+#include "lc_profiler.h"
 #include "rs_arc.h"
 #include "rs_block.h"
 #include "rs_circle.h"
@@ -131,6 +132,7 @@ RS_Entity* RS_Insert::clone() const{
  * needs to be called whenever the block this insert is based on changes.
  */
 void RS_Insert::update() {
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionRegeneration, RS2::EntityInsert);
 
     RS_DEBUG->print("RS_Insert::update");
     RS_DEBUG->print("RS_Insert::update: name: %s", m_data.name.toLatin1().data());
@@ -258,7 +260,8 @@ void RS_Insert::update() {
                 }
             }
         }
-        calculateBorders();
+        // the new entities have their borders already
+        refreshBorders();
 
         RS_DEBUG->print("RS_Insert::update: OK");
 }
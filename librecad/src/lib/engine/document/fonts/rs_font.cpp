@@ -26,7 +26,14 @@
 
 #include <iostream>
 
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
 #include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QTextStream>
 #include "rs_font.h"
 
@@ -75,6 +82,11 @@ std::pair<QString, bool> extractFontChar(const QString& line)
     char32_t ucsCode{code};
     return {QString::fromUcs4(&ucsCode, 1), true};
 }
+
+// Binary cache of parsed font files. The version must be increased on any change of the format.
+constexpr quint32 FONT_CACHE_MAGIC = 0x4C434643; // "LCFC"
+constexpr quint32 FONT_CACHE_VERSION = 1;
+const char* const FONT_CACHE_SUFFIX = ".lcfont";
 }
 
 /**
@@ -103,14 +115,18 @@ RS_Font::RS_Font(const QString& fileName, bool owner)
 bool RS_Font::loadFont() {
     RS_DEBUG->print("RS_Font::loadFont");
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (loaded) {
         return true;
     }
 
     QString path;
 
+    if (!m_filePath.isEmpty()) {
+        path = m_filePath;
+    }
     // Search for the appropriate font if we have only the name of the font:
-    if (!m_fileName.contains(".cxf", Qt::CaseInsensitive) &&
+    else if (!m_fileName.contains(".cxf", Qt::CaseInsensitive) &&
         !m_fileName.contains(".lff", Qt::CaseInsensitive)) {
         QStringList fonts = RS_SYSTEM->getNewFontList();
         fonts.append(RS_SYSTEM->getFontList());
@@ -145,10 +161,18 @@ bool RS_Font::loadFont() {
     }
     f.close();
 
+    // parsed letters are read from the binary cache of the font file, if it's up to date
+    const QString cacheFile = cacheFileName(path);
+    if (!readCache(cacheFile, path)) {
+        if (path.contains(".cxf"))
+            readCXF(path);
+        if (path.contains(".lff"))
+            readLFF(path);
+        writeCache(cacheFile, path);
+    }
+    // letters of cxf fonts are expected to be in the letter list right after loading
     if (path.contains(".cxf"))
-        readCXF(path);
-    if (path.contains(".lff"))
-        readLFF(path);
+        generateAllFonts();
 
     RS_Block* bk = letterList.find(QChar(0xfffd));
     if (!bk) {
@@ -245,9 +269,7 @@ void RS_Font::readCXF(const QString& path) {
                 ch = line.first(1);
             }
 
-            // create new letter:
-            RS_FontChar* letter =
-                new RS_FontChar(nullptr, ch, RS_Vector(0.0, 0.0));
+            Glyph glyph;
 
             // Read entities of this letter:
             QString coordsStr;
@@ -276,10 +298,7 @@ void RS_Font::readCXF(const QString& path) {
                     double x2 = (*it2++).toDouble();
                     double y2 = (*it2).toDouble();
 
-                    RS_Line* line = new RS_Line{letter, {{x1, y1}, {x2, y2}}};
-                    line->setPen(RS_Pen(RS2::FlagInvalid));
-                    line->setLayer(nullptr);
-                    letter->addEntity(line);
+                    glyph.push_back({GlyphPart::Line, {}, {x1, y1, x2, y2}});
                 }
 
                 // Arc:
@@ -291,21 +310,11 @@ void RS_Font::readCXF(const QString& path) {
                     double a2 = RS_Math::deg2rad((*it2).toDouble());
                     bool reversed = (line.at(1)=='R');
 
-                    RS_ArcData ad(RS_Vector(cx,cy),
-                                  r, a1, a2, reversed);
-                    RS_Arc* arc = new RS_Arc(letter, ad);
-                    arc->setPen(RS_Pen(RS2::FlagInvalid));
-                    arc->setLayer(nullptr);
-                    letter->addEntity(arc);
+                    glyph.push_back({GlyphPart::Arc, {}, {cx, cy, r, a1, a2, reversed ? 1. : 0.}});
                 }
             } while (!line.isEmpty());
 
-            if (letter->isEmpty()) {
-                delete letter;
-            } else {
-                letter->calculateBorders();
-                letterList.add(letter);
-            }
+            addGlyph(ch, std::move(glyph));
         }
     }
 }
@@ -380,22 +389,190 @@ void RS_Font::readLFF(const QString& path) {
             // QString letterName = letterNameToHexUnicodeCode(ch);
             QString letterName = ch;
 
-            QStringList fontData;
+            Glyph glyph;
             do {
                 line = ts.readLine();
                 if(line.isEmpty()) break;
-                fontData.push_back(line);
+
+                // Defined char:
+                if (line.at(0)=='C') {
+                    line.remove(0,1);
+                    glyph.push_back({GlyphPart::Letter, charFromHex(line), {}});
+                    continue;
+                }
+                //sequence:
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+                QStringList vertex = line.split(';', Qt::SkipEmptyParts);
+#else
+                QStringList vertex = line.split(';', QString::SkipEmptyParts);
+#endif
+                //at least is required two vertex
+                if (vertex.size()<2)
+                    continue;
+                GlyphPart pline{GlyphPart::Polyline, {}, {}};
+                pline.values.reserve(3 * vertex.size());
+                foreach(const QString& point, vertex) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+                    QStringList coords = point.split(',', Qt::SkipEmptyParts);
+#else
+                    QStringList coords = point.split(',', QString::SkipEmptyParts);
+#endif
+                    //at least X,Y is required
+                    double x1 = coords.at(0).toDouble();
+                    // Issue #2045, if y-coordinate is missing, default to 0
+                    double y1 = coords.size() >= 2 ? coords.at(1).toDouble() : 0.;
+                    //check presence of bulge
+                    double bulge = 0;
+                    if (coords.size() >= 3 && coords.at(2).at(0) == QChar('A')){
+                        QString bulgeStr = coords.at(2);
+                        bulge = bulgeStr.remove(0,1).toDouble();
+                    }
+                    pline.values.insert(pline.values.end(), {x1, y1, bulge});
+                }
+                glyph.push_back(std::move(pline));
             } while(true);
-            if (!fontData.isEmpty()                             // valid data
-                && !rawLffFontList.contains( letterName)) {    // ignore duplicates
-                rawLffFontList[letterName] = fontData;
+            addGlyph(letterName, std::move(glyph));
+        }
+    }
+}
+
+/**
+ * Adds the parsed letter, the first one wins for duplicates.
+ */
+void RS_Font::addGlyph(const QString& letterName, Glyph glyph) {
+    if (!glyph.empty()                                 // valid data
+        && !rawLffFontList.contains(letterName)) {    // ignore duplicates
+        rawLffFontList.insert(letterName, std::move(glyph));
+    }
+}
+
+/**
+ * @return file of the binary cache for the given font file. The name contains the hash of the
+ * font file path, so fonts with the same name in different directories don't share the cache.
+ */
+QString RS_Font::cacheFileName(const QString& path) {
+    QFileInfo info(path);
+    QByteArray pathHash = QCryptographicHash::hash(info.absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fonts/"
+           + info.completeBaseName() + "-" + QString::fromLatin1(pathHash) + FONT_CACHE_SUFFIX;
+}
+
+/**
+ * Reads parsed letters and settings of the font from the binary cache. The cache file is memory
+ * mapped and decoded without any text parsing.
+ * @return false if there is no cache, or it's outdated or invalid. The font is unchanged then.
+ */
+bool RS_Font::readCache(const QString& cacheFile, const QString& path) {
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 size = file.size();
+    const uchar* mapped = file.map(0, size);
+    QByteArray data = mapped != nullptr
+                          ? QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<qsizetype>(size))
+                          : file.readAll();
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0, version = 0;
+    qint64 sourceSize = 0, sourceModified = 0;
+    in >> magic >> version >> sourceSize >> sourceModified;
+    QFileInfo source(path);
+    if (in.status() != QDataStream::Ok || magic != FONT_CACHE_MAGIC || version != FONT_CACHE_VERSION
+        || sourceSize != source.size() || sourceModified != source.lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+
+    QString cachedLicense, cachedCreate, cachedEncoding;
+    QStringList cachedNames, cachedAuthors;
+    double cachedLetterSpacing = 0., cachedWordSpacing = 0., cachedLineSpacingFactor = 0.;
+    in >> cachedLicense >> cachedCreate >> cachedEncoding >> cachedNames >> cachedAuthors
+        >> cachedLetterSpacing >> cachedWordSpacing >> cachedLineSpacingFactor;
+
+    quint32 glyphsCount = 0;
+    in >> glyphsCount;
+    QMap<QString, Glyph> glyphs;
+    for (quint32 i = 0; i < glyphsCount && in.status() == QDataStream::Ok; i++) {
+        QString letterName;
+        quint32 partsCount = 0;
+        in >> letterName >> partsCount;
+        Glyph glyph;
+        for (quint32 j = 0; j < partsCount && in.status() == QDataStream::Ok; j++) {
+            quint8 type = 0;
+            quint32 valuesCount = 0;
+            GlyphPart part;
+            in >> type >> part.letter >> valuesCount;
+            if (type > GlyphPart::Letter || valuesCount > static_cast<quint32>(size)) {
+                return false;
+            }
+            part.type = static_cast<GlyphPart::Type>(type);
+            part.values.resize(valuesCount);
+            for (double& value: part.values) {
+                in >> value;
             }
+            glyph.push_back(std::move(part));
         }
+        glyphs.insert(letterName, std::move(glyph));
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    fileLicense = cachedLicense;
+    fileCreate = cachedCreate;
+    encoding = cachedEncoding;
+    names = cachedNames;
+    authors = cachedAuthors;
+    letterSpacing = cachedLetterSpacing;
+    wordSpacing = cachedWordSpacing;
+    lineSpacingFactor = cachedLineSpacingFactor;
+    rawLffFontList = std::move(glyphs);
+    return true;
+}
+
+/**
+ * Writes parsed letters and settings of the font to the binary cache. The cache is
+ * invalidated by size and modification time of the font file.
+ */
+void RS_Font::writeCache(const QString& cacheFile, const QString& path) const {
+    if (!QDir().mkpath(QFileInfo(cacheFile).absolutePath())) {
+        return;
+    }
+    // readers must never see a partially written cache
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_15);
+
+    QFileInfo source(path);
+    out << FONT_CACHE_MAGIC << FONT_CACHE_VERSION << qint64(source.size())
+        << qint64(source.lastModified().toMSecsSinceEpoch());
+    out << fileLicense << fileCreate << encoding << names << authors
+        << letterSpacing << wordSpacing << lineSpacingFactor;
+
+    out << quint32(rawLffFontList.size());
+    for (auto it = rawLffFontList.cbegin(); it != rawLffFontList.cend(); ++it) {
+        out << it.key() << quint32(it.value().size());
+        for (const GlyphPart& part: it.value()) {
+            out << quint8(part.type) << part.letter << quint32(part.values.size());
+            for (double value: part.values) {
+                out << value;
+            }
+        }
+    }
+    if (out.status() == QDataStream::Ok) {
+        file.commit();
+    } else {
+        file.cancelWriting();
     }
 }
 
 void RS_Font::generateAllFonts()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     for(const QString& key : rawLffFontList.keys())
         generateLffFont(key);
 }
@@ -414,23 +591,15 @@ RS_Block* RS_Font::generateLffFont(const QString& key)
     // create new letter:
     auto letter = std::make_unique<RS_FontChar>(nullptr, key, RS_Vector(0.0, 0.0));
 
-    // Read entities of this letter:
-    QStringList fontData = rawLffFontList[key];
-
-    while(!fontData.isEmpty()) {
-        QString line = fontData.takeFirst();
-
-        if (line.isEmpty()) {
-            continue;
-        }
+    // Create entities of this letter:
+    const Glyph glyph = rawLffFontList.value(key);
 
+    for (const GlyphPart& part: glyph) {
         // Defined char:
-        if (line.at(0)=='C') {
-            line.remove(0,1);
-            auto uCode = line.toUInt(nullptr, 16);
-            auto ch = charFromHex(line);
+        if (part.type == GlyphPart::Letter) {
+            const QString& ch = part.letter;
             if (ch == key) {   // recursion, a character can't include itself
-                LC_ERR<<QString{"RS_Font::generateLffFont([%1]) : recursion, ignore this character from %2"}.arg(uCode, 4, 16).arg(m_fileName);
+                LC_ERR<<QString{"RS_Font::generateLffFont([%1]) : recursion, ignore this character from %2"}.arg(ch.at(0).unicode(), 4, 16).arg(m_fileName);
                 return nullptr;
             }
 
@@ -450,41 +619,35 @@ RS_Block* RS_Font::generateLffFont(const QString& key)
                 letter->addEntity(bk2);
             }
         }
+        // cxf line:
+        else if (part.type == GlyphPart::Line && part.values.size() == 4) {
+            const std::vector<double>& v = part.values;
+            RS_Line* line = new RS_Line{letter.get(), {{v[0], v[1]}, {v[2], v[3]}}};
+            line->setPen(RS_Pen(RS2::FlagInvalid));
+            line->setLayer(nullptr);
+            letter->addEntity(line);
+        }
+        // cxf arc:
+        else if (part.type == GlyphPart::Arc && part.values.size() == 6) {
+            const std::vector<double>& v = part.values;
+            RS_ArcData ad(RS_Vector(v[0], v[1]), v[2], v[3], v[4], v[5] != 0.);
+            RS_Arc* arc = new RS_Arc(letter.get(), ad);
+            arc->setPen(RS_Pen(RS2::FlagInvalid));
+            arc->setLayer(nullptr);
+            letter->addEntity(arc);
+        }
         //sequence:
-        else {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-            QStringList vertex = line.split(';', Qt::SkipEmptyParts);
-#else
-            QStringList vertex = line.split(';', QString::SkipEmptyParts);
-#endif \
-    //at least is required two vertex
-            if (vertex.size()<2)
-                continue;
+        else if (part.type == GlyphPart::Polyline) {
             RS_Polyline* pline = new RS_Polyline(letter.get(), RS_PolylineData());
             pline->setPen(RS_Pen(RS2::FlagInvalid));
             pline->setLayer(nullptr);
-            foreach(const QString& point, vertex) {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-                QStringList coords = point.split(',', Qt::SkipEmptyParts);
-#else
-                QStringList coords = point.split(',', QString::SkipEmptyParts);
-#endif \
-    //at least X,Y is required
-                double x1 = coords.at(0).toDouble();
-                // Issue #2045, if y-coordinate is missing, default to 0
-                double y1 = coords.size() >= 2 ? coords.at(1).toDouble() : 0.;
-                //check presence of bulge
-                double bulge = 0;
-                if (coords.size() >= 3 && coords.at(2).at(0) == QChar('A')){
-                    QString bulgeStr = coords.at(2);
-                    bulge = bulgeStr.remove(0,1).toDouble();
-                }
+            for (size_t i = 0; i + 2 < part.values.size(); i += 3) {
+                double bulge = part.values[i + 2];
                 pline->setNextBulge(bulge);
-                pline->addVertex(RS_Vector(x1, y1), bulge);
+                pline->addVertex(RS_Vector(part.values[i], part.values[i + 1]), bulge);
             }
             letter->addEntity(pline);
         }
-
     }
 
     if (!letter->isEmpty()) {
@@ -498,6 +661,7 @@ RS_Block* RS_Font::generateLffFont(const QString& key)
 }
 
 RS_Block* RS_Font::findLetter(const QString& name) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     RS_Block* ret= letterList.find(name);
     return (ret != nullptr) ? ret : generateLffFont(name);
 
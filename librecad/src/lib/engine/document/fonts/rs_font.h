@@ -28,6 +28,9 @@
 #ifndef RS_FONT_H
 #define RS_FONT_H
 
+#include <mutex>
+#include <vector>
+
 #include <QMap>
 #include <QStringList>
 
@@ -112,19 +115,45 @@ public:
     friend class RS_FontList;
 
 private:
+    /**
+     * Part of a parsed letter: a polyline of (x, y, bulge) vertices, a line (x1, y1, x2, y2),
+     * an arc (cx, cy, r, angle1, angle2, reversed) or another letter included as whole.
+     */
+    struct GlyphPart {
+        enum Type {
+            Polyline,
+            Line,
+            Arc,
+            Letter
+        };
+        Type type = Polyline;
+        QString letter;
+        std::vector<double> values;
+    };
+    using Glyph = std::vector<GlyphPart>;
+
     void readCXF(const QString& path);
     void readLFF(const QString& path);
+    void addGlyph(const QString& letterName, Glyph glyph);
+    bool readCache(const QString& cacheFile, const QString& path);
+    void writeCache(const QString& cacheFile, const QString& path) const;
+    static QString cacheFileName(const QString& path);
     RS_Block* generateLffFont(const QString& key);
 
 private:
-    //raw lff font file list, not processed into blocks yet
-    QMap<QString, QStringList> rawLffFontList;
+    //! guards lazy loading and letter generation, letters may be requested from worker threads
+    std::recursive_mutex m_mutex;
+
+    //! parsed letters of the font file, not processed into blocks yet
+    QMap<QString, Glyph> rawLffFontList;
 
     //! block list (letters)
     RS_BlockList letterList;
 
     //! Font file name
     QString m_fileName;
+    //! full path of the font file, resolved by the font list on the gui thread, as searching reads settings
+    QString m_filePath;
 
     //! Font file license
     QString fileLicense;
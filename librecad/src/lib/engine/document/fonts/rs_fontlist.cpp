@@ -49,10 +49,17 @@ RS_FontList* RS_FontList::instance() {
  * objects, one for each font that could be found.
  */
 void RS_FontList::init() {
-    RS_DEBUG->print("RS_FontList::initFonts");
-
     QStringList list = RS_SYSTEM->getNewFontList();
     list.append(RS_SYSTEM->getFontList());
+    init(list);
+}
+
+/**
+ * Initializes the list from the font files found already, lff files are expected first.
+ */
+void RS_FontList::init(const QStringList& list) {
+    RS_DEBUG->print("RS_FontList::initFonts");
+
     QHash<QString, int> added; //used to remember added fonts (avoid duplication)
 
     for (int i = 0; i < list.size(); ++i) {
@@ -61,6 +68,8 @@ void RS_FontList::init() {
         QFileInfo fi( list.at(i) );
         if ( !added.contains(fi.baseName()) ) {
 			fonts.emplace_back(new RS_Font(fi.baseName()));
+            // the first file found for the name, the same as RS_Font::loadFont() would search for
+            fonts.back()->m_filePath = fi.absoluteFilePath();
             added.insert(fi.baseName(), 1);
         }
 
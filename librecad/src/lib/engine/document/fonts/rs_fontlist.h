@@ -28,7 +28,8 @@
 #include <memory>
 #include <vector>
 
-class QString;
+#include <QStringList>
+
 class RS_Font;
 
 #define RS_FONTLIST RS_FontList::instance()
@@ -50,6 +51,7 @@ public:
     virtual ~RS_FontList() = default;
 
     void init();
+    void init(const QStringList& fontFiles);
 
     void clearFonts();
     size_t countFonts() const;
@@ -122,6 +122,11 @@ bool RS_Pattern::loadPattern() {
             addEntity(cl);
         }
 	}
+    // normalize the tile to start at the origin, so its borders are the tile size
+    calculateBorders();
+    if (!isEmpty()) {
+        move(-getMin());
+    }
 
     loaded = true;
     RS_DEBUG->print("RS_Pattern::loadPattern: OK");
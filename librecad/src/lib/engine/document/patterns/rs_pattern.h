@@ -35,7 +35,8 @@ class RS_PatternList;
 
 /**
  * Patterns are used for hatches. They are stored in a RS_PatternList.
- * Use RS_PatternList to access a pattern.
+ * Use RS_PatternList to access a pattern. Loaded patterns are shared
+ * by all hatches and not modified, the tile starts at the origin.
  *
  * @author Andrew Mustun
  */
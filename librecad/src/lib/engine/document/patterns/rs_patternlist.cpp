@@ -48,17 +48,23 @@ RS_PatternList::~RS_PatternList() = default;
  * objects, one for each pattern that could be found.
  */
 void RS_PatternList::init() {
-    RS_DEBUG->print("RS_PatternList::initPatterns");
+    init(RS_SYSTEM->getPatternList());
+}
 
-	QStringList list = RS_SYSTEM->getPatternList();
+/**
+ * Initializes the list from the pattern files found already.
+ */
+void RS_PatternList::init(const QStringList& list) {
+    RS_DEBUG->print("RS_PatternList::initPatterns");
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 	patterns.clear();
 
     foreach(auto const& s, list) {
         RS_DEBUG->print("pattern: %s:", s.toLatin1().data());
 
         QString const name = QFileInfo(s).baseName().toLower();
-        patterns.emplace(name, std::unique_ptr<RS_Pattern>{});
+        patterns.emplace(name, std::shared_ptr<const RS_Pattern>{});
 
         RS_DEBUG->print("base: %s", name.toLatin1().data());
     }
@@ -70,19 +76,20 @@ void RS_PatternList::init() {
 /**
  * @return Pointer to the pattern with the given name or
  * \p NULL if no such pattern was found. The pattern will be loaded into
- * memory if it's not already.
+ * memory if it's not already. Loaded patterns are shared and immutable,
+ * clone the pattern to modify it.
  */
-std::unique_ptr<RS_Pattern> RS_PatternList::requestPattern(const QString& name) {
+std::shared_ptr<const RS_Pattern> RS_PatternList::requestPattern(const QString& name) {
     RS_DEBUG->print("RS_PatternList::requestPattern %s", name.toLatin1().data());
 
     QString name2 = name.toLower();
     RS_DEBUG->print("Pattern: name2: %s", name2.toLatin1().data());
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (patterns.count(name2) == 0 || patterns.at(name2) == nullptr) {
-        auto p = std::make_unique<RS_Pattern>(name2);
+        auto p = std::make_shared<RS_Pattern>(name2);
         if (p!=nullptr) {
             if (p->loadPattern()) {
-                patterns.emplace(name2,  std::unique_ptr<RS_Pattern>{});
-                patterns[name2].swap(p);
+                patterns[name2] = std::move(p);
             }
             else {
                 patterns.erase(name2);
@@ -98,7 +105,7 @@ std::unique_ptr<RS_Pattern> RS_PatternList::requestPattern(const QString& name)
     if (patterns.count(name2) == 1) {
         RS_DEBUG->print("name2: %s, size= %d", name2.toLatin1().data(),
                         patterns[name2]->countDeep());
-        return std::unique_ptr<RS_Pattern>{static_cast<RS_Pattern*>(patterns[name2]->clone())};
+        return patterns[name2];
 	}
 
     return {};
@@ -108,6 +115,7 @@ std::unique_ptr<RS_Pattern> RS_PatternList::requestPattern(const QString& name)
 	
 bool RS_PatternList::contains(const QString& name) const {
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 	return patterns.count(name.toLower());
 
 }
@@ -121,7 +129,7 @@ std::ostream& operator << (std::ostream& os, RS_PatternList& l) {
     os << "Patternlist: \n";
 	for (auto const& pa: l.patterns)
 		if (pa.second)
-			os<< *pa.second << '\n';
+			os<< pa.first.toLatin1().data() << ": " << pa.second->count() << " entities\n";
 
     return os;
 }
@@ -29,9 +29,11 @@
 #define RS_PATTERNLIST_H
 #include <map>
 #include <memory>
+#include <mutex>
+
+#include <QStringList>
 
 class RS_Pattern;
-class QString;
 
 #define RS_PATTERNLIST RS_PatternList::instance()
 
@@ -42,7 +44,7 @@ class QString;
  * @author Andrew Mustun
  */
 class RS_PatternList {
-	using PTN_MAP = std::map<QString, std::unique_ptr<RS_Pattern>>;
+	using PTN_MAP = std::map<QString, std::shared_ptr<const RS_Pattern>>;
 	RS_PatternList() = default;
 
 public:
@@ -58,6 +60,7 @@ public:
 	RS_PatternList& operator = (RS_PatternList &&) = delete;
 
 	void init();
+	void init(const QStringList& patternFiles);
 
 	int countPatterns() const {
 		return static_cast<int>(patterns.size());
@@ -78,7 +81,7 @@ public:
 	}
 	//! \}
 
-    std::unique_ptr<RS_Pattern> requestPattern(const QString& name);
+    std::shared_ptr<const RS_Pattern> requestPattern(const QString& name);
 
 	bool contains(const QString& name) const;
 
@@ -88,6 +91,8 @@ public:
 private:
     //! patterns in the graphic
     PTN_MAP patterns;
+    //! patterns are requested by hatches updated on worker threads
+    mutable std::recursive_mutex m_mutex;
 };
 
 #endif
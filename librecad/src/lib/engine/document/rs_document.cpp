@@ -39,6 +39,7 @@ RS_Document::RS_Document(RS_EntityContainer* parent)
     : RS_EntityContainer{parent}
     , activePen {RS_Color{RS2::FlagByLayer}, RS2::WidthByLayer, RS2::LineByLayer}{
     RS_DEBUG->print("RS_Document::RS_Document() ");
+    enableSelectionTracking();
 }
 
 /**
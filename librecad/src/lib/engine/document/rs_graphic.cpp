@@ -30,6 +30,7 @@
 
 #include "dxf_format.h"
 #include "lc_defaults.h"
+#include "lc_resolveddimstyle.h"
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
 #include "rs_dialogfactoryinterface.h"
@@ -112,6 +113,7 @@ RS_Graphic::RS_Graphic(RS_EntityContainer* parent)
         setAnglesCounterClockwise(anglesCounterClockwise);
         setAnglesBase(angleBaseRadians);
     }
+    m_unitlessGrid = LC_GET_ONE_BOOL("Appearance", "UnitlessGrid", true);
     RS2::Unit unit = getUnit();
 
     if (unit == RS2::Inch) {
@@ -232,6 +234,7 @@ void RS_Graphic::newDoc() {
 
 void RS_Graphic::clearVariables() {
     variableDict.clear();
+    invalidateResolvedDimStyle();
 }
 
 int RS_Graphic::countVariables() const{
@@ -240,26 +243,68 @@ int RS_Graphic::countVariables() const{
 
 void RS_Graphic::addVariable(const QString& key, const RS_Vector& value, int code) {
     variableDict.add(key, value, code);
+    invalidateResolvedDimStyle();
 }
 
 void RS_Graphic::addVariable(const QString& key, const QString& value, int code) {
     variableDict.add(key, value, code);
+    invalidateResolvedDimStyle();
 }
 
 void RS_Graphic::addVariable(const QString& key, int value, int code) {
     variableDict.add(key, value, code);
+    invalidateResolvedDimStyle();
 }
 
 void RS_Graphic::addVariable(const QString& key, bool value, int code) {
     variableDict.add(key, value, code);
+    invalidateResolvedDimStyle();
 }
 
 void RS_Graphic::addVariable(const QString& key, double value, int code) {
     variableDict.add(key, value, code);
+    invalidateResolvedDimStyle();
 }
 
 void RS_Graphic::removeVariable(const QString& key) {
     variableDict.remove(key);
+    invalidateResolvedDimStyle();
+}
+
+void RS_Graphic::setVariableDictObject(RS_VariableDict inputVariableDict) {
+    variableDict = inputVariableDict;
+    invalidateResolvedDimStyle();
+}
+
+/**
+ * @return dimension style resolved from the variables. It's shared by all dimensions of the graphic and rebuilt
+ * on the first request after any variable change. The first request after a change should be done by the thread
+ * owning the document, as resolving adds missing dimension variables.
+ */
+std::shared_ptr<const LC_ResolvedDimStyle> RS_Graphic::getResolvedDimStyle() {
+    std::lock_guard<std::recursive_mutex> lock(m_resolvedDimStyleMutex);
+    if (m_resolvedDimStyle == nullptr) {
+        // resolving may add variables and so invalidate the style, it's fine as it's assigned afterwards
+        auto style = LC_ResolvedDimStyle::create(this);
+        m_resolvedDimStyle = std::move(style);
+    }
+    return m_resolvedDimStyle;
+}
+
+void RS_Graphic::invalidateResolvedDimStyle() {
+    std::lock_guard<std::recursive_mutex> lock(m_resolvedDimStyleMutex);
+    m_resolvedDimStyle.reset();
+}
+
+/**
+ * Sets the value of the "Appearance/UnitlessGrid" setting used for dimensions, to be called
+ * by the owner of the document when the setting changes.
+ */
+void RS_Graphic::setUnitlessGrid(bool unitless) {
+    if (m_unitlessGrid != unitless) {
+        m_unitlessGrid = unitless;
+        invalidateResolvedDimStyle();
+    }
 }
 
 RS_Vector RS_Graphic::getVariableVector(const QString& key, const RS_Vector& def) const {
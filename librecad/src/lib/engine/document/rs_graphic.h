@@ -24,6 +24,9 @@
 #ifndef RS_GRAPHIC_H
 #define RS_GRAPHIC_H
 
+#include <memory>
+#include <mutex>
+
 #include <QDateTime>
 
 #include "lc_ucslist.h"
@@ -35,6 +38,7 @@
 #include "lc_dimstyleslist.h"
 
 class LC_DimStylesList;
+struct LC_ResolvedDimStyle;
 class QString;
 
 class LC_View;
@@ -136,7 +140,13 @@ public:
         return variableDict;
     }
 
-    void setVariableDictObject(RS_VariableDict inputVariableDict) {variableDict = inputVariableDict;}
+    void setVariableDictObject(RS_VariableDict inputVariableDict);
+
+    std::shared_ptr<const LC_ResolvedDimStyle> getResolvedDimStyle();
+    void invalidateResolvedDimStyle();
+
+    bool isUnitlessGrid() const {return m_unitlessGrid;}
+    void setUnitlessGrid(bool unitless);
 
     RS2::LinearFormat getLinearFormat() const;
     RS2::LinearFormat convertLinearFormatDXF2LC(int f) const;
@@ -273,6 +283,11 @@ private:
     LC_ViewList namedViewsList;
     LC_UCSList ucsList;
     LC_DimStylesList dimstyleList;
+    // dimension style resolved from variables, rebuilt on first request after a variable change
+    std::shared_ptr<const LC_ResolvedDimStyle> m_resolvedDimStyle;
+    std::recursive_mutex m_resolvedDimStyleMutex;
+    // "Appearance/UnitlessGrid" setting, read on construction so dimensions never read settings from workers
+    bool m_unitlessGrid = true;
     //if set to true, will refuse to modify paper scale
     bool paperScaleFixed = false;
 
@@ -182,15 +182,17 @@ void RS_Preview::addCloneOf(RS_Entity* entity, [[maybe_unused]]LC_GraphicViewpor
 void RS_Preview::addAllFrom(RS_EntityContainer& container, [[maybe_unused]]LC_GraphicViewport* view) {
     unsigned int c=0;
     for(auto e: container){
-        if (c < m_maxEntities) {
-            RS_Entity* clone = e->cloneProxy();
-            clone->setSelected(false);
-            clone->reparent(this);
-
-            c+=clone->countDeep();
-            addEntity(clone);
-            // clone might be nullptr after this point
+        // large clipboards: stop at the limit instead of visiting the rest
+        if (c >= m_maxEntities) {
+            break;
         }
+        RS_Entity* clone = e->cloneProxy();
+        clone->setSelected(false);
+        clone->reparent(this);
+
+        c+=clone->countDeep();
+        addEntity(clone);
+        // clone might be nullptr after this point
     }
 }
 
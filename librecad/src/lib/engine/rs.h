@@ -882,6 +882,7 @@ namespace RS2 {
                 RedrawGrid = 1,
                 RedrawOverlay = 2,
                 RedrawDrawing = 4,
+                RedrawViewport = 8, // zoom, pan or ucs are changed, yet the drawing itself is the same
                 RedrawAll = 0xffff
         };
 
@@ -552,9 +552,19 @@ QStringList RS_System::getFileList(const QString& subDirectory,
     RS_DEBUG->print( "RS_System::getFileList: appDirName %s ", appDirName.toLatin1().data());
     RS_DEBUG->print( "RS_System::getFileList: getCurrentDir %s ", getCurrentDir().toLatin1().data());
 
-    QStringList fileList;
+    QStringList fileList = getFileList( getDirectoryList( subDirectory), fileExtension);
+
+    LC_LOG<<__func__<<"():: fileList:";
+    foreach(const auto& file, fileList)
+        LC_LOG<<file;
 
-    auto directoryList = getDirectoryList( subDirectory);
+    return fileList;
+}
+
+QStringList RS_System::getFileList(const QStringList& directoryList,
+                                   const QString& fileExtension)
+{
+    QStringList fileList;
 
     foreach(const QString& path, directoryList) {
         QDir dir {path};
@@ -567,11 +577,6 @@ QStringList RS_System::getFileList(const QString& subDirectory,
             }
         }
     }
-
-    LC_LOG<<__func__<<"():: fileList:";
-    foreach(const auto& file, fileList)
-        LC_LOG<<file;
-
     return fileList;
 }
 
@@ -155,6 +155,13 @@ public:
     QStringList getFileList (const QString& subDirectory,
                             const QString& fileExtension) const;
 
+    /**
+     * @return A list of absolute paths to files with the given extension in the given directories.
+     * Doesn't read the settings, so it may be called from any thread.
+     */
+    static QStringList getFileList(const QStringList& directoryList,
+                                   const QString& fileExtension);
+
     QStringList getDirectoryList(const QString&
 		   subDirectory) const;
 
@@ -54,3 +54,9 @@ void LC_UndoSection::addUndoable(RS_Undoable *undoable){
         document->addUndoable( undoable);
     }
 }
+
+void LC_UndoSection::addUndoables(const std::vector<RS_Undoable*>& undoables){
+    if (valid) {
+        document->addUndoables(undoables);
+    }
+}
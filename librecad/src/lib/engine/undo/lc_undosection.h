@@ -26,6 +26,7 @@
 #ifndef LC_UNDOSECTION_H
 #define LC_UNDOSECTION_H
 
+#include <vector>
 
 class RS_Document;
 class RS_Undoable;
@@ -48,6 +49,7 @@ public:
     ~LC_UndoSection();
 
     void addUndoable(RS_Undoable * undoable);
+    void addUndoables(const std::vector<RS_Undoable*>& undoables);
 
 private:
     RS_Document *document {nullptr};
@@ -133,6 +133,17 @@ void RS_Undo::addUndoable(RS_Undoable* u) {
     RS_DEBUG->print("RS_Undo::%s(): end", __func__);
 }
 
+/**
+ * Adds undoables to the current undo cycle at once.
+ */
+void RS_Undo::addUndoables(const std::vector<RS_Undoable*>& undoables) {
+    if( nullptr == currentCycle) {
+        RS_DEBUG->print( RS_Debug::D_CRITICAL, "RS_Undo::%s(): invalid currentCycle, possibly missing startUndoCycle()", __func__);
+        return;
+    }
+    currentCycle->addUndoables(undoables);
+}
+
 /**
  * Ends the current undo cycle.
  */
@@ -56,6 +56,7 @@ public:
 
     virtual void startUndoCycle();
     virtual void addUndoable(RS_Undoable* u);
+    void addUndoables(const std::vector<RS_Undoable*>& undoables);
     virtual void endUndoCycle();
 
     /**
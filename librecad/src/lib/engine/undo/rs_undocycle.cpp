@@ -41,6 +41,14 @@ void RS_UndoCycle::addUndoable(RS_Undoable* u) {
         undoables.insert(u);
 }
 
+void RS_UndoCycle::addUndoables(const std::vector<RS_Undoable*>& list) {
+    for (RS_Undoable* u: list) {
+        if (u != nullptr) {
+            undoables.insert(u);
+        }
+    }
+}
+
 /**
  * Removes an undoable from the list.
  */
@@ -31,6 +31,7 @@
 
 #include <iosfwd>
 #include <set>
+#include <vector>
 
 #include "rs_undoable.h"
 
@@ -59,6 +60,7 @@ public:
      * more Undoables.
      */
     void addUndoable(RS_Undoable* u);
+    void addUndoables(const std::vector<RS_Undoable*>& list);
 
     /**
      * Removes an undoable from the list.
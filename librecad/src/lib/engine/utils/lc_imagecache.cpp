@@ -0,0 +1,202 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include "lc_imagecache.h"
+#include "rs_debug.h"
+#include "rs_settings.h"
+
+namespace {
+// levels are not built below this size, full image is fine for drawing small images
+constexpr int MIN_LEVEL_SIZE = 256;
+
+qint64 imageBytes(const QImage& image) {
+    return static_cast<qint64>(image.sizeInBytes());
+}
+}
+
+LC_CachedImage::LC_CachedImage(const QImage& image):m_image(image) {
+}
+
+QImage LC_CachedImage::getLevel(double scale, int& levelFactor) {
+    m_lastUse = LC_IMAGECACHE->nextUseStamp();
+    levelFactor = 1;
+    if (scale <= 0. || scale >= 0.5 || std::max(m_image.width(), m_image.height()) <= MIN_LEVEL_SIZE) {
+        return m_image;
+    }
+    // the smallest level that still has at least one pixel per device pixel
+    int wantedLevel = static_cast<int>(std::floor(std::log2(1. / scale)));
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_levels.empty()) {
+        if (!m_levelsRequested) {
+            m_levelsRequested = true;
+            lock.unlock();
+            LC_IMAGECACHE->requestLevels(shared_from_this());
+        }
+        return m_image;
+    }
+    int level = std::min(wantedLevel, static_cast<int>(m_levels.size()));
+    levelFactor = 1 << level;
+    return m_levels[level - 1];
+}
+
+qint64 LC_CachedImage::getLevelsBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    qint64 result = 0;
+    for (const QImage& level: m_levels) {
+        result += imageBytes(level);
+    }
+    return result;
+}
+
+void LC_CachedImage::buildLevels() {
+    std::vector<QImage> levels;
+    QImage previous = m_image;
+    while (std::max(previous.width(), previous.height()) > MIN_LEVEL_SIZE
+           && std::min(previous.width(), previous.height()) >= 2) {
+        QImage level = previous.scaled(previous.width() / 2, previous.height() / 2,
+                                       Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        levels.push_back(level);
+        previous = level;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_levels = std::move(levels);
+}
+
+void LC_CachedImage::dropLevels() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_levels.clear();
+    m_levelsRequested = false;
+}
+
+LC_ImageCache* LC_ImageCache::instance() {
+    static LC_ImageCache cache;
+    return &cache;
+}
+
+LC_ImageCache::LC_ImageCache() {
+    // levels are built one at a time, so loading of many images does not starve rendering threads
+    m_threadPool.setMaxThreadCount(1);
+    m_memoryBudget = static_cast<qint64>(LC_GET_ONE_INT("Render", "ImageCacheSize", 512)) * 1024 * 1024;
+}
+
+LC_ImageCache::~LC_ImageCache() {
+    m_threadPool.clear();
+    m_threadPool.waitForDone();
+}
+
+std::shared_ptr<LC_CachedImage> LC_ImageCache::acquire(const QString& filePath) {
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists()) {
+        return nullptr;
+    }
+    QString key = QString("%1|%2|%3").arg(fileInfo.canonicalFilePath())
+                                     .arg(fileInfo.lastModified().toMSecsSinceEpoch())
+                                     .arg(fileInfo.size());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_images.constFind(key);
+        if (it != m_images.cend()) {
+            it.value()->m_lastUse = nextUseStamp();
+            return it.value();
+        }
+    }
+
+    // decoding is done without lock, concurrent requests for the same new file are rare and the first wins
+    QImage image(fileInfo.canonicalFilePath());
+    if (image.isNull()) {
+        return nullptr;
+    }
+    auto cached = std::make_shared<LC_CachedImage>(image);
+    cached->m_lastUse = nextUseStamp();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_images.constFind(key);
+        if (it != m_images.cend()) {
+            return it.value();
+        }
+        m_images.insert(key, cached);
+    }
+    trim();
+    return cached;
+}
+
+void LC_ImageCache::setMemoryBudget(qint64 bytes) {
+    m_memoryBudget = bytes;
+    trim();
+}
+
+void LC_ImageCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_images.clear();
+}
+
+void LC_ImageCache::requestLevels(std::shared_ptr<LC_CachedImage> image) {
+    m_threadPool.start([this, image]{
+        image->buildLevels();
+        trim();
+    });
+}
+
+void LC_ImageCache::trim() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    struct Usage {
+        QString key;
+        quint64 lastUse;
+        qint64 levelsBytes;
+    };
+    std::vector<Usage> usages;
+    qint64 total = 0;
+    for (auto it = m_images.cbegin(); it != m_images.cend(); ++it) {
+        qint64 levelsBytes = it.value()->getLevelsBytes();
+        total += imageBytes(it.value()->getImage()) + levelsBytes;
+        usages.push_back({it.key(), it.value()->m_lastUse, levelsBytes});
+    }
+    if (total <= m_memoryBudget) {
+        return;
+    }
+
+    std::sort(usages.begin(), usages.end(), [](const Usage& a, const Usage& b) {
+        return a.lastUse < b.lastUse;
+    });
+    for (const Usage& usage: usages) {
+        if (total <= m_memoryBudget) {
+            break;
+        }
+        std::shared_ptr<LC_CachedImage>& image = m_images[usage.key];
+        if (image.use_count() == 1) {
+            // not referenced by any entity
+            total -= imageBytes(image->getImage()) + usage.levelsBytes;
+            m_images.remove(usage.key);
+        } else if (usage.levelsBytes > 0) {
+            total -= usage.levelsBytes;
+            image->dropLevels();
+        }
+    }
+    RS_DEBUG->print("LC_ImageCache::trim: %lld bytes in %d images", total, static_cast<int>(m_images.size()));
+}
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_IMAGECACHE_H
+#define LC_IMAGECACHE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QHash>
+#include <QImage>
+#include <QString>
+#include <QThreadPool>
+
+#define LC_IMAGECACHE LC_ImageCache::instance()
+
+/**
+ * Decoded raster image shared by all image entities referring to the same file.
+ *
+ * Besides the full resolution image it holds a pyramid of downscaled levels (each level halves the size of previous
+ * one). Levels are built on a worker thread on first request, until they are ready the full image is returned.
+ */
+class LC_CachedImage : public std::enable_shared_from_this<LC_CachedImage> {
+public:
+    explicit LC_CachedImage(const QImage& image);
+    const QImage& getImage() const {return m_image;}
+    QSize getSize() const {return m_image.size();}
+    bool isNull() const {return m_image.isNull();}
+
+    /**
+     * Returns the level to draw with given number of device pixels per image pixel.
+     * @param scale device pixels per pixel of full resolution image
+     * @param levelFactor set to number of full resolution pixels per pixel of returned image
+     */
+    QImage getLevel(double scale, int& levelFactor);
+    qint64 getLevelsBytes() const;
+protected:
+    friend class LC_ImageCache;
+    void buildLevels();
+    void dropLevels();
+
+    const QImage m_image;
+    mutable std::mutex m_mutex;
+    std::vector<QImage> m_levels; // m_levels[i] is downscaled by 2^(i+1)
+    bool m_levelsRequested = false;
+    std::atomic<quint64> m_lastUse{0};
+};
+
+/**
+ * Process-wide cache of decoded raster images, keyed by canonical file path and modification time, so the same file
+ * is decoded once regardless of number of entities, clones and documents that refer to it.
+ *
+ * Memory of downscaled levels and of images no longer used by any entity is kept within the budget by evicting least
+ * recently drawn images first. Full resolution images in use are never evicted.
+ */
+class LC_ImageCache {
+public:
+    static LC_ImageCache* instance();
+    ~LC_ImageCache();
+
+    /**
+     * Returns shared image for the file; the file is decoded only if it is not in the cache or was modified since.
+     * Returns nullptr if the file can't be read.
+     */
+    std::shared_ptr<LC_CachedImage> acquire(const QString& filePath);
+    void setMemoryBudget(qint64 bytes);
+    void clear();
+protected:
+    LC_ImageCache();
+    friend class LC_CachedImage;
+    void requestLevels(std::shared_ptr<LC_CachedImage> image);
+    quint64 nextUseStamp() {return ++m_useCounter;}
+    void trim();
+
+    std::mutex m_mutex;
+    QHash<QString, std::shared_ptr<LC_CachedImage>> m_images;
+    qint64 m_memoryBudget = 0;
+    std::atomic<quint64> m_useCounter{0};
+    QThreadPool m_threadPool;
+};
+
+#endif // LC_IMAGECACHE_H
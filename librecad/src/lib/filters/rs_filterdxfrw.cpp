@@ -23,6 +23,7 @@
 **
 **********************************************************************/
 
+#include <algorithm>
 #include<cstdlib>
 #include <QRegularExpression>
 #include <QStringList>
@@ -32,6 +33,9 @@
 
 #include <QFile>
 #include <QFileInfo>
+#include <QCoreApplication>
+#include <QThread>
+#include <QThreadPool>
 
 #include "lc_parabola.h"
 #include "rs_arc.h"
@@ -75,6 +79,11 @@
 
 #endif
 
+namespace {
+// entities updated by one pool task, keeps the task queue short
+constexpr size_t DEFERRED_UPDATE_BATCH = 64;
+}
+
 /**
  * Default constructor.
  *
@@ -105,6 +114,7 @@ RS_FilterDXFRW::RS_FilterDXFRW()
  * Destructor.
  */
 RS_FilterDXFRW::~RS_FilterDXFRW() {
+    finishDeferredUpdates();
     RS_DEBUG->print("RS_FilterDXFRW::~RS_FilterDXFRW(): OK");
 }
 
@@ -139,6 +149,8 @@ QString RS_FilterDXFRW::lastError() const
         return (QObject::tr( "error reading DXF/DWG sections", "RS_FilterDXFRW"));
     case DRW::BAD_CODE_PARSED:
         return (QObject::tr( "error reading DXF/DWG code", "RS_FilterDXFRW"));
+    case DRW::BAD_CANCELLED:
+        return (QObject::tr( "reading DXF/DWG file cancelled", "RS_FilterDXFRW"));
     default:
         break;
     }
@@ -166,6 +178,16 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
 	dummyContainer = new RS_EntityContainer(nullptr, true);
 
     this->file = file;
+    m_deferredUpdates.clear();
+    m_postponedUpdates.clear();
+    m_updatePool.reset();
+    m_updatesDeferred = false;
+    // importing off the GUI thread means that files are already imported concurrently
+    m_useUpdatePool = QThread::idealThreadCount() > 1 && QCoreApplication::instance() != nullptr
+                      && QThread::currentThread() == QCoreApplication::instance()->thread();
+    m_importLayers.clear();
+    m_importLineTypes.clear();
+    m_attributesParent = nullptr;
     // add some variables that need to be there for DXF drawings:
     graphic->addVariable("$DIMSTYLE", "Standard", 2);
     dimStyle = "Standard";
@@ -182,6 +204,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
         if (RS_DEBUG->getLevel()== RS_Debug::D_DEBUGGING)
             dwgr.setDebug(DRW::DebugLevel::Debug);
         bool success = dwgr.read(this, true);
+        finishDeferredUpdates();
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file: OK");
         RS_DIALOGFACTORY->commandMessage(QObject::tr("Opened dwg file version %1.").arg(printDwgVersion(dwgr.getVersion())));
         int  lastError = dwgr.getError();
@@ -201,6 +224,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
             dxfR.setDebug(DRW::DebugLevel::Debug);
         }
         bool success = dxfR.read(this, true);
+        finishDeferredUpdates();
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading file: OK");
         //graphic->setAutoUpdateBorders(true);
 
@@ -215,6 +239,14 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
 #endif
 
     delete dummyContainer;
+    if (m_updatesDeferred) {
+        // deferred entities were attached before their geometry existed
+        for (RS_Block* blk: *graphic->getBlockList()) {
+            blk->calculateBorders();
+        }
+        graphic->calculateBorders();
+    }
+    m_updatePool.reset();
     /*set current layer */
     RS_Layer* cl = graphic->findLayer(graphic->getVariableString("$CLAYER", "0"));
 	if (cl ){
@@ -484,6 +516,76 @@ void RS_FilterDXFRW::endBlock() {
 }
 
 
+/**
+ * Updates the geometry of an entity which was already attached to the
+ * current container. Updates of texts, dimensions and splines dominate
+ * the import time of annotated drawings, so they run on a thread pool.
+ * Updates read the graphic (variables like $SPLINESEGS, fonts, the
+ * dimension style, active layer and pen of created sub-entities), which
+ * the reader still changes, so entities are collected and updated by
+ * finishDeferredUpdates() once the reading is finished and the graphic
+ * is not modified anymore.
+ *
+ * Without the pool (single core, or import off the GUI thread) the
+ * entity is updated at once.
+ */
+void RS_FilterDXFRW::deferUpdate(RS_Entity* entity) {
+    // *D blocks are deleted in endBlock(), never hand their entities out
+    bool discarded = version != 1009 && currentContainer->rtti() == RS2::EntityBlock
+                     && static_cast<RS_Block*>(currentContainer)->getName().startsWith("*D");
+    if (discarded || !m_useUpdatePool) {
+        entity->update();
+        return;
+    }
+    m_updatesDeferred = true;
+    m_postponedUpdates.push_back(entity);
+}
+
+void RS_FilterDXFRW::startUpdatePool() {
+    if (m_updatePool == nullptr) {
+        m_updatePool = std::make_unique<QThreadPool>();
+        // one core stays with the reader
+        m_updatePool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+    }
+}
+
+void RS_FilterDXFRW::submitDeferredUpdates() {
+    if (m_deferredUpdates.empty()) {
+        return;
+    }
+    startUpdatePool();
+    m_updatePool->start([batch = std::move(m_deferredUpdates)]() {
+        for (RS_Entity* entity: batch) {
+            entity->update();
+        }
+    });
+    m_deferredUpdates.clear();
+}
+
+/**
+ * Runs updates postponed till the end of reading and waits for all
+ * queued entity updates. Must be called before the imported entities
+ * are read or deleted.
+ */
+void RS_FilterDXFRW::finishDeferredUpdates() {
+    if (!m_postponedUpdates.empty()) {
+        // resolve the shared dimension style here, workers only read it
+        graphic->getResolvedDimStyle();
+        // the reading is finished, so workers only read the graphic
+        std::vector<RS_Entity*> postponed = std::move(m_postponedUpdates);
+        m_postponedUpdates.clear();
+        for (size_t i = 0; i < postponed.size(); i += DEFERRED_UPDATE_BATCH) {
+            m_deferredUpdates.assign(postponed.begin() + i,
+                                     postponed.begin() + std::min(postponed.size(), i + DEFERRED_UPDATE_BATCH));
+            submitDeferredUpdates();
+        }
+    }
+    if (m_updatePool != nullptr) {
+        m_updatePool->waitForDone();
+    }
+}
+
+
 
 /**
  * Implementation of the method which handles point entities.
@@ -679,6 +781,7 @@ void RS_FilterDXFRW::addTolerance(const DRW_Tolerance& data) {
 
     LC_Tolerance* entity = new LC_Tolerance{currentContainer, tolData};
     setEntityAttributes(entity, &data);
+    // not deferred: the update may add missing $DIM variables to the graphic
     entity->update();
     currentContainer->addEntity(entity);
 }
@@ -761,8 +864,8 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
                                toRs(data->controllist.at(2))}};
             auto* parabola = new LC_Parabola(currentContainer, d);
             setEntityAttributes(parabola, data);
-            parabola->update();
             currentContainer->addEntity(parabola);
+            deferUpdate(parabola);
             return;
         }
         else { // spline points
@@ -780,7 +883,7 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
                 splinePoints->addPoint({vert->x, vert->y});
             }
 
-            splinePoints->update();
+            deferUpdate(splinePoints);
             return;
         }
     }
@@ -816,7 +919,7 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
     if (spline->data.closed and !spline->hasWrappedControlPoints())
         spline->data.closed = 0;
 
-    spline->update();
+    deferUpdate(spline);
 }
 
 
@@ -955,8 +1058,8 @@ void RS_FilterDXFRW::addMText(const DRW_MText& data) {
     RS_MText* entity = new RS_MText(currentContainer, d);
 
     setEntityAttributes(entity, &data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 
@@ -1014,8 +1117,8 @@ void RS_FilterDXFRW::addText(const DRW_Text& data) {
     RS_Text* entity = new RS_Text(currentContainer, d);
 
     setEntityAttributes(entity, &data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 
@@ -1103,8 +1206,8 @@ void RS_FilterDXFRW::addDimAlign(const DRW_DimAligned *data) {
                             dimensionData, d);
     setEntityAttributes(entity, data);
     entity->updateDimPoint();
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 /**
@@ -1125,8 +1228,8 @@ void RS_FilterDXFRW::addDimLinear(const DRW_DimLinear *data) {
     RS_DimLinear* entity = new RS_DimLinear(currentContainer,
                                             dimensionData, d);
     setEntityAttributes(entity, data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 
@@ -1147,8 +1250,8 @@ void RS_FilterDXFRW::addDimRadial(const DRW_DimRadial* data) {
                                             dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 
@@ -1169,8 +1272,8 @@ void RS_FilterDXFRW::addDimDiametric(const DRW_DimDiametric* data) {
                               dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 
@@ -1194,8 +1297,8 @@ void RS_FilterDXFRW::addDimAngular(const DRW_DimAngular* data) {
                             dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 /**
@@ -1218,8 +1321,8 @@ void RS_FilterDXFRW::addDimAngular3P(const DRW_DimAngular3p* data) {
                             dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 void RS_FilterDXFRW::addDimOrdinate(const DRW_DimOrdinate* data) {
@@ -1237,8 +1340,8 @@ void RS_FilterDXFRW::addDimOrdinate(const DRW_DimOrdinate* data) {
     LC_DimOrdinateData d(featurePoint, leaderEndPoint, ordinateTypeForX);
     auto* entity = new LC_DimOrdinate(currentContainer, dimensionData, d);
     setEntityAttributes(entity, data);
-    entity->update();
     currentContainer->addEntity(entity);
+    deferUpdate(entity);
 }
 
 /**
@@ -3337,15 +3440,16 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
     RS_Pen pen;
     pen.setColor(Qt::black);
     pen.setLineType(RS2::SolidLine);
-    QString layName = toNativeString(QString::fromUtf8(attrib->layer.c_str()));
 
-    // Layer: add layer in case it doesn't exist:
-	if (!graphic->findLayer(layName)) {
-        DRW_Layer lay;
-        lay.name = attrib->layer;
-        addLayer(lay);
+    // Layer: add layer in case it doesn't exist. Only entities of the graphic get
+    // the layer, like RS_Entity::setLayer(QString) does
+    RS_Layer* layer = resolveLayer(attrib->layer);
+    RS_EntityContainer* parent = entity->getParent();
+    if (parent != m_attributesParent) {
+        m_attributesParent = parent;
+        m_attributesParentInGraphic = parent != nullptr && parent->getGraphic() != nullptr;
     }
-    entity->setLayer(layName);
+    entity->setLayer(m_attributesParentInGraphic ? layer : nullptr);
 
     // Color:
     if (attrib->color24 >= 0)
@@ -3356,7 +3460,7 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
     pen.setColor(numberToColor(attrib->color));
 
     // Linetype:
-    pen.setLineType(nameToLineType( QString::fromUtf8(attrib->lineType.c_str()) ));
+    pen.setLineType(resolveLineType(attrib->lineType));
 
     // Width:
     pen.setWidth(numberToWidth(attrib->lWeight));
@@ -3367,6 +3471,39 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
 
 
 
+/**
+ * Finds the layer of an imported entity by the name stored in the file, the layer is added
+ * in case it doesn't exist. Names are converted and looked up only once per import.
+ */
+RS_Layer* RS_FilterDXFRW::resolveLayer(const std::string& name) {
+    auto it = m_importLayers.find(name);
+    if (it != m_importLayers.end()) {
+        return it->second;
+    }
+    QString layName = toNativeString(QString::fromUtf8(name.c_str()));
+    if (!graphic->findLayer(layName)) {
+        DRW_Layer lay;
+        lay.name = name;
+        addLayer(lay);
+    }
+    RS_Layer* layer = graphic->findLayer(layName);
+    m_importLayers.emplace(name, layer);
+    return layer;
+}
+
+/**
+ * Line type of an imported entity by the name stored in the file, converted once per import.
+ */
+RS2::LineType RS_FilterDXFRW::resolveLineType(const std::string& name) {
+    auto it = m_importLineTypes.find(name);
+    if (it != m_importLineTypes.end()) {
+        return it->second;
+    }
+    RS2::LineType lineType = nameToLineType(QString::fromUtf8(name.c_str()));
+    m_importLineTypes.emplace(name, lineType);
+    return lineType;
+}
+
 /**
  * Gets the entities attributes as a DL_Attributes object.
  */
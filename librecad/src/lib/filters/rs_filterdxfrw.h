@@ -27,6 +27,11 @@
 #ifndef RS_FILTERDXFRW_H
 #define RS_FILTERDXFRW_H
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "rs_filterinterface.h"
 
 #include "rs_color.h"
@@ -35,6 +40,8 @@
 #include "libdxfrw.h"
 
 class LC_DimStyle;
+class RS_Layer;
+class QThreadPool;
 class RS_Point;
 class RS_Line;
 class RS_Circle;
@@ -84,6 +91,7 @@ public:
     bool fileImport(RS_Graphic& g, const QString& file, RS2::FormatType type) override;
 
     // Methods from DRW_CreationInterface:
+    bool isCancelled() override {return isImportCancelled();}
     void addHeader(const DRW_Header* data) override;
     void addLType(const DRW_LType& /*data*/) override{}
     void addLayer(const DRW_Layer& data) override;
@@ -204,6 +212,12 @@ public:
     static RS_FilterInterface* createFilter(){return new RS_FilterDXFRW();}
 
 private:
+    RS_Layer* resolveLayer(const std::string& name);
+    RS2::LineType resolveLineType(const std::string& name);
+    void deferUpdate(RS_Entity* entity);
+    void startUpdatePool();
+    void submitDeferredUpdates();
+    void finishDeferredUpdates();
     void prepareBlocks();
     void writeEntity(RS_Entity* e);
 #ifdef DWGSUPPORT
@@ -243,6 +257,19 @@ private:
     /** Pointer to entity container to store possible orphan entities like paper space */
     RS_EntityContainer* dummyContainer;
     LC_DimStyle *createDimStyle(const DRW_Dimstyle &s);
+    /** Layers and line types resolved during the import, by names as they are stored in the file. */
+    std::unordered_map<std::string, RS_Layer*> m_importLayers;
+    std::unordered_map<std::string, RS2::LineType> m_importLineTypes;
+    /** Last parent of an imported entity, and whether it belongs to the graphic. */
+    RS_EntityContainer* m_attributesParent = nullptr;
+    bool m_attributesParentInGraphic = false;
+    /** Batch of entities submitted for their update() to the import thread pool. */
+    std::vector<RS_Entity*> m_deferredUpdates;
+    /** Entities, which update() reads the graphic, updated once the reading is finished. */
+    std::vector<RS_Entity*> m_postponedUpdates;
+    std::unique_ptr<QThreadPool> m_updatePool;
+    bool m_useUpdatePool = false;
+    bool m_updatesDeferred = false;
 };
 
 #endif
@@ -29,6 +29,9 @@
 #ifndef RS_FILTERINTERFACE_H
 #define RS_FILTERINTERFACE_H
 
+#include <atomic>
+#include <memory>
+
 #include "rs_graphic.h"
 
 #include <QObject>
@@ -102,8 +105,21 @@ public:
 
     static RS_FilterInterface * createFilter(){return NULL;}
 
+    /**
+     * Sets the flag, which is checked by filters supporting it while importing. Once the flag
+     * is set, the import stops and fails.
+     */
+    void setCancelFlag(std::shared_ptr<const std::atomic<bool>> flag) {
+        cancelFlag = std::move(flag);
+    }
+
 protected:
+    bool isImportCancelled() const {
+        return cancelFlag != nullptr && cancelFlag->load();
+    }
+
     int errorCode {0};  //< error code for last import/export action
+    std::shared_ptr<const std::atomic<bool>> cancelFlag;
 };
 
 #endif
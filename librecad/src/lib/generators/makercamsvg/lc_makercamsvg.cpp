@@ -23,6 +23,9 @@
 
 #include "lc_makercamsvg.h"
 
+#include <cmath>
+#include <unordered_map>
+
 #include "lc_splinepoints.h"
 #include "lc_xmlwriterinterface.h"
 #include "rs_arc.h"
@@ -76,7 +79,7 @@ bool LC_MakerCamSVG::generate(RS_Graphic* graphic) {
 
     write(graphic);
 
-    return true;
+    return xmlWriter->endDocument();
 }
 
 std::string LC_MakerCamSVG::resultAsString() {
@@ -169,13 +172,23 @@ void LC_MakerCamSVG::writeLayers(RS_Document* document) {
 
     RS_LayerList* layerlist = document->getLayerList();
 
-    for (unsigned int i = 0; i < layerlist->count(); i++) {
+    // distribute entities by layers in one pass, so export time doesn't depend on the amount of layers
+    std::unordered_map<RS_Layer*, std::vector<RS_Entity*>> entitiesByLayer;
+    for (auto e: *document) {
+        if (!(e->getFlag(RS2::FlagUndone))) {
+            entitiesByLayer[e->getLayer()].push_back(e);
+        }
+    }
 
-        writeLayer(document, layerlist->at(i));
+    const std::vector<RS_Entity*> noEntities;
+    for (unsigned int i = 0; i < layerlist->count(); i++) {
+        RS_Layer* layer = layerlist->at(i);
+        auto it = entitiesByLayer.find(layer);
+        writeLayer(layer, it == entitiesByLayer.end() ? noEntities : it->second);
     }
 }
 
-void LC_MakerCamSVG::writeLayer(RS_Document* document, RS_Layer* layer) {
+void LC_MakerCamSVG::writeLayer(RS_Layer* layer, const std::vector<RS_Entity*>& entities) {
 
     if (writeInvisibleLayers || !layer->isFrozen()) {
 
@@ -197,9 +210,9 @@ void LC_MakerCamSVG::writeLayer(RS_Document* document, RS_Layer* layer) {
 
             xmlWriter->addAttribute("fill", "none");
             xmlWriter->addAttribute("stroke", "black");
-            xmlWriter->addAttribute("stroke-width", QString::number(defaultElementWidth).toStdString());
+            xmlWriter->addAttribute("stroke-width", numXml(defaultElementWidth));
 
-            writeEntities(document, layer);
+            writeEntities(entities);
 
             xmlWriter->closeElement();
         }
@@ -216,19 +229,13 @@ void LC_MakerCamSVG::writeLayer(RS_Document* document, RS_Layer* layer) {
     }
 }
 
-void LC_MakerCamSVG::writeEntities(RS_Document* document, RS_Layer* layer) {
+void LC_MakerCamSVG::writeEntities(const std::vector<RS_Entity*>& entities) {
 
     RS_DEBUG->print("RS_MakerCamSVG::writeEntities: Writing entities from layer ...");
 
-	for (auto e: *document) {
-
-        if (e->getLayer() == layer) {
+    for (auto e: entities) {
 
-            if (!(e->getFlag(RS2::FlagUndone))) {
-
-                writeEntity(e);
-            }
-        }
+        writeEntity(e);
     }
 }
 
@@ -358,11 +365,11 @@ void LC_MakerCamSVG::writeLine(RS_Line* line) {
         path += svgPathAnyLineType(startpoint, endpoint, pen.getLineType());
 
         xmlWriter->addElement("path", NAMESPACE_URI_SVG);
-        xmlWriter->addAttribute("id", QString::number(line->getId()).toStdString());
+        xmlWriter->addAttribute("id", std::to_string(line->getId()));
         if (RS2::Width00 != pen.getWidth()){
-            xmlWriter->addAttribute("stroke-width", QString::number((pen.getWidth()/100.0)).toStdString());
+            xmlWriter->addAttribute("stroke-width", numXml(pen.getWidth()/100.0));
          } else {
-            xmlWriter->addAttribute("stroke-width", QString::number(defaultElementWidth).toStdString());
+            xmlWriter->addAttribute("stroke-width", numXml(defaultElementWidth));
         }
         xmlWriter->addAttribute("d", path);
         xmlWriter->closeElement();
@@ -770,9 +777,42 @@ std::vector<RS_Vector> LC_MakerCamSVG::calcQuadraticBezierPoints(const std::vect
     return bezier_points;
 }
 
+/**
+ * Locale independent equivalent of RS_Utility::doubleToString(value, 8): fixed notation with
+ * at most 8 decimals and without trailing zeros. It avoids QString round-trip for every number.
+ */
 std::string LC_MakerCamSVG::numXml(double value) {
+    // beyond this range value scaled by 1e8 doesn't fit into long long
+    if (!std::isfinite(value) || std::abs(value) >= 9e10) {
+        return RS_Utility::doubleToString(value, 8).toStdString();
+    }
 
-    return RS_Utility::doubleToString(value, 8).toStdString();
+    constexpr unsigned long long decimalsScale = 100000000ULL;
+    long long scaled = std::llround(value * decimalsScale);
+    bool negative = scaled < 0;
+    unsigned long long absScaled = negative ? static_cast<unsigned long long>(-scaled) : static_cast<unsigned long long>(scaled);
+
+    std::string result;
+    if (negative) {
+        result += '-';
+    }
+    result += std::to_string(absScaled / decimalsScale);
+
+    unsigned long long fraction = absScaled % decimalsScale;
+    if (fraction != 0) {
+        char digits[8];
+        for (int i = 7; i >= 0; i--) {
+            digits[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        int length = 8;
+        while (digits[length - 1] == '0') {
+            length--;
+        }
+        result += '.';
+        result.append(digits, length);
+    }
+    return result;
 }
 
 std::string LC_MakerCamSVG::lengthXml(double value) const
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rs.h"
 #include "rs_vector.h"
@@ -82,9 +83,9 @@ private:
     void writeBlock(RS_Block* block);
 
     void writeLayers(RS_Document* document);
-    void writeLayer(RS_Document* document, RS_Layer* layer);
+    void writeLayer(RS_Layer* layer, const std::vector<RS_Entity*>& entities);
 
-    void writeEntities(RS_Document* document, RS_Layer* layer);
+    void writeEntities(const std::vector<RS_Entity*>& entities);
     void writeEntity(RS_Entity* entity);
 
     void writeInsert(RS_Insert* insert);
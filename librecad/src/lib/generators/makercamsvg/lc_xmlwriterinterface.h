@@ -38,6 +38,12 @@ public:
 
     virtual void closeElement() = 0;
 
+    /**
+     * Closes all open elements and finishes the document.
+     * @return false if the document could not be written
+     */
+    virtual bool endDocument() = 0;
+
     virtual std::string documentAsString() = 0;
 
 	LC_XMLWriterInterface() = default;
@@ -56,8 +56,16 @@ void LC_XMLWriterQXmlStreamWriter::closeElement() {
     xmlWriter->writeEndElement();
 }
 
+bool LC_XMLWriterQXmlStreamWriter::endDocument() {
+    if (!ended) {
+        xmlWriter->writeEndDocument();
+        ended = true;
+    }
+    return !xmlWriter->hasError();
+}
+
 std::string LC_XMLWriterQXmlStreamWriter::documentAsString() {
-    xmlWriter->writeEndDocument();
+    endDocument();
 
     return xml.toStdString();
 }
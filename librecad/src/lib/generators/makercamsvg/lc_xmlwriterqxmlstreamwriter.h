@@ -46,6 +46,8 @@ public:
 
     void closeElement() override;
 
+    bool endDocument() override;
+
     std::string documentAsString() override;
 
 private:
@@ -53,6 +55,7 @@ private:
 	std::unique_ptr<QXmlStreamWriter> xmlWriter;
 
     QString xml;
+    bool ended = false;
 };
 
 #endif
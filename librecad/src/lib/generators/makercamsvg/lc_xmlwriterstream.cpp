@@ -0,0 +1,194 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QIODevice>
+
+#include "lc_xmlwriterstream.h"
+
+namespace {
+    // buffered output is written to the device when it exceeds this size
+    constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+}
+
+LC_XMLWriterStream::LC_XMLWriterStream(QIODevice *device):
+    m_device{device} {
+    m_buffer.reserve(FLUSH_THRESHOLD + 1024);
+}
+
+LC_XMLWriterStream::~LC_XMLWriterStream() {
+    endDocument();
+}
+
+void LC_XMLWriterStream::createRootElement(const std::string &name, const std::string &namespace_uri) {
+    m_defaultNamespace = namespace_uri;
+    m_buffer += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    addElement(name, namespace_uri);
+    if (!namespace_uri.empty()) {
+        m_buffer += " xmlns=\"";
+        appendEscaped(namespace_uri);
+        m_buffer += '"';
+    }
+}
+
+void LC_XMLWriterStream::addElement(const std::string &name, const std::string &namespace_uri) {
+    finishStartTag();
+    if (!m_openElements.empty()) {
+        m_buffer += '\n';
+    }
+    indent();
+    std::string qName = qualifiedName(name, namespace_uri);
+    m_buffer += '<';
+    m_buffer += qName;
+    m_openElements.push_back(std::move(qName));
+    m_startTagOpen = true;
+}
+
+void LC_XMLWriterStream::addAttribute(const std::string &name, const std::string &value, const std::string &namespace_uri) {
+    if (!m_startTagOpen) {
+        return;
+    }
+    m_buffer += ' ';
+    if (!namespace_uri.empty()) {
+        auto it = m_prefixes.find(namespace_uri);
+        if (it != m_prefixes.end()) {
+            m_buffer += it->second;
+            m_buffer += ':';
+        }
+    }
+    m_buffer += name;
+    m_buffer += "=\"";
+    appendEscaped(value);
+    m_buffer += '"';
+}
+
+void LC_XMLWriterStream::addNamespaceDeclaration(const std::string &prefix, const std::string &namespace_uri) {
+    m_prefixes[namespace_uri] = prefix;
+    if (m_startTagOpen) {
+        m_buffer += " xmlns:";
+        m_buffer += prefix;
+        m_buffer += "=\"";
+        appendEscaped(namespace_uri);
+        m_buffer += '"';
+    }
+}
+
+void LC_XMLWriterStream::closeElement() {
+    if (m_openElements.empty()) {
+        return;
+    }
+    if (m_startTagOpen) {
+        m_buffer += "/>";
+        m_startTagOpen = false;
+        m_openElements.pop_back();
+    }
+    else {
+        std::string qName = std::move(m_openElements.back());
+        m_openElements.pop_back();
+        m_buffer += '\n';
+        indent();
+        m_buffer += "</";
+        m_buffer += qName;
+        m_buffer += '>';
+    }
+    flush();
+}
+
+bool LC_XMLWriterStream::endDocument() {
+    if (!m_ended) {
+        while (!m_openElements.empty()) {
+            closeElement();
+        }
+        m_buffer += '\n';
+        m_ended = true;
+        flush(true);
+    }
+    return !m_failed;
+}
+
+std::string LC_XMLWriterStream::documentAsString() {
+    endDocument();
+    return m_device == nullptr ? m_buffer : std::string{};
+}
+
+std::string LC_XMLWriterStream::qualifiedName(const std::string &name, const std::string &namespace_uri) const {
+    if (namespace_uri.empty() || namespace_uri == m_defaultNamespace) {
+        return name;
+    }
+    auto it = m_prefixes.find(namespace_uri);
+    if (it == m_prefixes.end()) {
+        return name;
+    }
+    return it->second + ":" + name;
+}
+
+void LC_XMLWriterStream::finishStartTag() {
+    if (m_startTagOpen) {
+        m_buffer += '>';
+        m_startTagOpen = false;
+    }
+}
+
+void LC_XMLWriterStream::indent() {
+    size_t depth = m_openElements.size();
+    m_buffer.append(depth * 4, ' ');
+}
+
+void LC_XMLWriterStream::appendEscaped(const std::string &value) {
+    for (char c: value) {
+        switch (c) {
+            case '&':
+                m_buffer += "&amp;";
+                break;
+            case '<':
+                m_buffer += "&lt;";
+                break;
+            case '>':
+                m_buffer += "&gt;";
+                break;
+            case '"':
+                m_buffer += "&quot;";
+                break;
+            case '\n':
+                m_buffer += "&#10;";
+                break;
+            case '\r':
+                m_buffer += "&#13;";
+                break;
+            case '\t':
+                m_buffer += "&#9;";
+                break;
+            default:
+                m_buffer += c;
+                break;
+        }
+    }
+}
+
+void LC_XMLWriterStream::flush(bool force) {
+    // without a device the whole document is kept in the buffer
+    if (m_device == nullptr || m_buffer.empty() || (!force && m_buffer.size() < FLUSH_THRESHOLD)) {
+        return;
+    }
+    if (m_device->write(m_buffer.data(), static_cast<qint64>(m_buffer.size())) < 0) {
+        m_failed = true;
+    }
+    m_buffer.clear();
+}
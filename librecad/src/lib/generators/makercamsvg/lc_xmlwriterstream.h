@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_XMLWRITERSTREAM_H
+#define LC_XMLWRITERSTREAM_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "lc_xmlwriterinterface.h"
+
+class QIODevice;
+
+/**
+ * XML writer that streams UTF-8 output directly to the device instead of building the whole
+ * document in memory. Output is buffered and written to the device by chunks, so memory used
+ * by the writer does not depend on the size of the document.
+ * Without a device the document is kept in memory and is available by documentAsString().
+ */
+class LC_XMLWriterStream : public LC_XMLWriterInterface {
+public:
+    explicit LC_XMLWriterStream(QIODevice* device = nullptr);
+    ~LC_XMLWriterStream() override;
+
+    void createRootElement(const std::string &name, const std::string &namespace_uri = "") override;
+    void addElement(const std::string &name, const std::string &namespace_uri = "") override;
+    void addAttribute(const std::string &name, const std::string &value, const std::string &namespace_uri = "") override;
+    void addNamespaceDeclaration(const std::string &prefix, const std::string &namespace_uri) override;
+    void closeElement() override;
+    bool endDocument() override;
+
+    /**
+     * Ends the document.
+     * @return the document, if the writer has no device. Content written to a device is not kept,
+     * so an empty string is returned in that case.
+     */
+    std::string documentAsString() override;
+
+private:
+    std::string qualifiedName(const std::string &name, const std::string &namespace_uri) const;
+    void finishStartTag();
+    void indent();
+    void appendEscaped(const std::string &value);
+    void flush(bool force = false);
+
+    QIODevice* m_device = nullptr;
+    std::string m_buffer;
+    std::string m_defaultNamespace;
+    std::map<std::string, std::string> m_prefixes;
+    std::vector<std::string> m_openElements;
+    bool m_startTagOpen = false;
+    bool m_ended = false;
+    bool m_failed = false;
+};
+
+#endif // LC_XMLWRITERSTREAM_H
@@ -22,6 +22,13 @@
 
 #include "lc_gridsystem.h"
 
+#include <cmath>
+
+#include <QLineF>
+#include <QPolygonF>
+#include <QRegion>
+#include <QVector>
+
 #include "lc_graphicviewport.h"
 #include "lc_lattice.h"
 #include "rs_painter.h"
@@ -121,6 +128,12 @@ void LC_GridSystem::setCellSize(const RS_Vector &gridWidth, const RS_Vector &met
 
 void LC_GridSystem::setOptions(std::unique_ptr<LC_GridSystem::LC_GridOptions> options) {
     gridOptions = std::move(options);
+    clearRenderCache();
+}
+
+void LC_GridSystem::clearRenderCache() {
+    m_renderCache.valid = false;
+    m_renderCache.pixmap = QPixmap();
 }
 
 void LC_GridSystem::invalidate() {
@@ -135,15 +148,115 @@ void LC_GridSystem::draw(RS_Painter *painter, LC_GraphicViewport *view) {
     if (isGridDisabledByPanning(view)){
         return;
     }
+    const bool cacheMetaGrid = isMetaGridCacheable();
+    const bool cacheGrid = isGridCacheable();
+    if (!cacheMetaGrid && !cacheGrid) {
+        clearRenderCache();
+        doDraw(painter, view);
+        return;
+    }
+    // meta grid is below the grid, so the layer that is not cached is drawn directly in its order
+    if (!cacheMetaGrid) {
+        drawMetaGrid(painter, view);
+    }
+
+    const int width = view->getWidth();
+    const int height = view->getHeight();
+    const QPointF origin{view->toGuiX(0.0), view->toGuiY(0.0)};
+    QRegion exposed{0, 0, width, height};
+    if (isRenderCacheMatching(painter, view, cacheMetaGrid, cacheGrid)) {
+        const QPointF shift = origin - m_renderCache.origin;
+        const int dx = static_cast<int>(std::lround(shift.x()));
+        const int dy = static_cast<int>(std::lround(shift.y()));
+        // offsets of the view are integers, so pans are expected to shift the grid by whole pixels
+        if (std::abs(shift.x() - dx) < 1e-6 && std::abs(shift.y() - dy) < 1e-6 && std::abs(dx) < width && std::abs(dy) < height) {
+            exposed = QRegion();
+            if (dx != 0 || dy != 0) {
+                m_renderCache.pixmap.scroll(dx, dy, m_renderCache.pixmap.rect(), &exposed);
+            }
+        }
+    }
     else {
-        // fixme - special handling of order if simplify grid painter to make grid over meta grid?
-        if (gridOptions->drawMetaGrid) {
-            drawMetaGrid(painter, view);
+        m_renderCache.pixmap = QPixmap(width, height);
+        m_renderCache.pixmap.fill(Qt::transparent);
+        m_renderCache.factor = view->getFactor();
+        m_renderCache.gridCellSize = gridCellSize;
+        m_renderCache.metaGridCellSize = metaGridCellSize;
+        m_renderCache.axisIndefinite = hasAxisIndefinite;
+        m_renderCache.indefiniteX = indefiniteX;
+        m_renderCache.drawingMode = painter->getDrawingMode();
+        m_renderCache.renderHints = static_cast<int>(painter->renderHints());
+        m_renderCache.metaGrid = cacheMetaGrid;
+        m_renderCache.grid = cacheGrid;
+        m_renderCache.valid = true;
+    }
+    m_renderCache.origin = origin;
+
+    if (!exposed.isEmpty()) {
+        RS_Painter cachePainter(&m_renderCache.pixmap);
+        // scrolling leaves the old image in the exposed area
+        cachePainter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const QRect& rect: exposed) {
+            cachePainter.fillRect(rect, Qt::transparent);
+        }
+        cachePainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        cachePainter.setViewPort(view);
+        cachePainter.setRenderHints(painter->renderHints());
+        cachePainter.setDrawingMode(painter->getDrawingMode());
+        cachePainter.setClipRegion(exposed);
+        if (cacheMetaGrid && gridOptions->drawMetaGrid) {
+            drawMetaGrid(&cachePainter, view);
         }
+        if (cacheGrid) {
+            drawGrid(&cachePainter, view);
+        }
+        cachePainter.end();
+    }
+    painter->drawPixmap(0, 0, m_renderCache.pixmap);
+    if (!cacheGrid) {
         drawGrid(painter, view);
     }
 }
 
+/**
+ * Dash patterns start at the ends of lines, which are placed by the view, so only solid lines may be scrolled.
+ * Meta grid lines are sparse, so the dashed meta grid (default) is drawn directly over cached grid points.
+ */
+bool LC_GridSystem::isMetaGridCacheable() const {
+    return !gridOptions->drawMetaGrid || gridOptions->metaGridLineType == RS2::SolidLine;
+}
+
+bool LC_GridSystem::isGridCacheable() const {
+    bool gridAsLines = gridOptions->drawLines || hasAxisIndefinite;
+    return !(gridOptions->drawGrid && gridAsLines && gridOptions->gridLineType != RS2::SolidLine);
+}
+
+bool LC_GridSystem::isRenderCacheMatching(RS_Painter *painter, LC_GraphicViewport *view, bool cacheMetaGrid, bool cacheGrid) const {
+    auto sameVector = [](const RS_Vector& a, const RS_Vector& b) {
+        return a.valid == b.valid && a.x == b.x && a.y == b.y;
+    };
+    const RenderCache& cache = m_renderCache;
+    return cache.valid
+           && cache.pixmap.width() == view->getWidth() && cache.pixmap.height() == view->getHeight()
+           && sameVector(cache.factor, view->getFactor())
+           && sameVector(cache.gridCellSize, gridCellSize)
+           && sameVector(cache.metaGridCellSize, metaGridCellSize)
+           && cache.axisIndefinite == hasAxisIndefinite
+           && cache.indefiniteX == indefiniteX
+           && cache.drawingMode == painter->getDrawingMode()
+           && cache.renderHints == static_cast<int>(painter->renderHints())
+           && cache.metaGrid == cacheMetaGrid
+           && cache.grid == cacheGrid;
+}
+
+void LC_GridSystem::doDraw(RS_Painter *painter, LC_GraphicViewport *view) {
+    // fixme - special handling of order if simplify grid painter to make grid over meta grid?
+    if (gridOptions->drawMetaGrid) {
+        drawMetaGrid(painter, view);
+    }
+    drawGrid(painter, view);
+}
+
 void LC_GridSystem::drawMetaGrid(RS_Painter *painter, LC_GraphicViewport *view) {
     RS_Pen pen = RS_Pen(gridOptions->metaGridColor, RS2::Width00, gridOptions->metaGridLineType);
     pen.setScreenWidth(gridOptions->metaGridLineWidthPx);
@@ -168,11 +281,19 @@ void LC_GridSystem::drawGrid(RS_Painter *painter, LC_GraphicViewport *view) {
 
 void LC_GridSystem::drawGridPoints(RS_Painter *painter, [[maybe_unused]]LC_GraphicViewport *view) {
     int pointsCount = getGridPointsCount();
+    // points are drawn in a single call, outside of the clip (exposed area of scrolled grid) they are skipped
+    const bool clipped = painter->hasClipping();
+    const QRectF clipRect = clipped ? painter->clipBoundingRect().adjusted(-1., -1., 1., 1.) : QRectF();
+    QPolygonF points;
+    points.reserve(pointsCount);
     for (int i = 0; i < pointsCount; i++){
         double pX = gridLattice->getPointX(i);
         double pY = gridLattice->getPointY(i);
-        painter->drawGridPoint(pX, pY);
+        if (!clipped || clipRect.contains(pX, pY)) {
+            points.append(QPointF(pX, pY));
+        }
     }
+    painter->drawPoints(points);
 }
 
 void LC_GridSystem::drawGridLines(RS_Painter *painter, LC_GraphicViewport *view) {
@@ -182,16 +303,25 @@ void LC_GridSystem::drawGridLines(RS_Painter *painter, LC_GraphicViewport *view)
 void LC_GridSystem::doDrawLines(RS_Painter *painter, [[maybe_unused]]LC_GraphicViewport *view, LC_Lattice* linesLattice) {
     int pointsCount = linesLattice->getPointsSize();
 //    LC_ERR << "Lines Points Count: " << pointsCount;
+    const bool clipped = painter->hasClipping();
+    const QRectF clipRect = clipped ? painter->clipBoundingRect().adjusted(-1., -1., 1., 1.) : QRectF();
+    QVector<QLineF> lines;
+    lines.reserve(pointsCount / 2);
     int i = 0;
-    while (i < pointsCount) {
+    while (i + 1 < pointsCount) {
         double startPointX = linesLattice->getPointX(i);
         double startPointY = linesLattice->getPointY(i);
         i++;
         double endPointX = linesLattice->getPointX(i);
         double endPointY = linesLattice->getPointY(i);
         i++;
-        painter->drawLineUISimple(startPointX, startPointY, endPointX, endPointY);
+        QLineF line{startPointX, startPointY, endPointX, endPointY};
+        // grid lines are horizontal, vertical or isometric, so their bounds are good enough for clipping
+        if (!clipped || clipRect.intersects(QRectF(line.p1(), line.p2()).normalized().adjusted(-1., -1., 1., 1.))) {
+            lines.append(line);
+        }
     }
+    painter->drawLines(lines);
 }
 
 int LC_GridSystem::getGridPointsCount() {
@@ -208,6 +338,7 @@ bool LC_GridSystem::isNumberOfPointsValid(int numberOfPoints){
 }
 
 void LC_GridSystem::clearGrid() {
+    clearRenderCache();
     gridLattice->init(0);
     if (metaGridLattice != nullptr){
         metaGridLattice->init(0);
@@ -25,6 +25,9 @@
 
 #include <memory>
 
+#include <QPixmap>
+#include <QPointF>
+
 #include "rs_vector.h"
 #include "rs_color.h"
 
@@ -64,6 +67,7 @@ public:
     virtual RS_Vector snapGrid(const RS_Vector &coord) const = 0;
     void createGrid(LC_GraphicViewport* view, const RS_Vector &viewZero, const RS_Vector &viewSize, const RS_Vector &metaGridWidth, const RS_Vector &gridWidth);
     void draw(RS_Painter *painter, LC_GraphicViewport* view);
+    void clearRenderCache();
 
     void clearGrid();
 
@@ -125,6 +129,32 @@ protected:
     bool hasAxisIndefinite = false;
     bool indefiniteX  = false;
 
+    /**
+     * Rendered grid. The lattice is periodic, so if the view is only panned by whole pixels, the cached image is
+     * scrolled and only the exposed area is drawn again. Other changes of the view or options drop the image.
+     * Dashed lines are not periodic with the lattice, so such layer is not cached and is drawn directly.
+     */
+    struct RenderCache {
+        QPixmap pixmap;
+        QPointF origin;  // gui position of ucs zero the image is rendered for
+        RS_Vector factor;
+        RS_Vector gridCellSize;
+        RS_Vector metaGridCellSize;
+        bool axisIndefinite = false;
+        bool indefiniteX = false;
+        RS2::DrawingMode drawingMode = RS2::ModeFull;
+        int renderHints = 0;
+        bool metaGrid = false; // layers that are rendered into the image
+        bool grid = false;
+        bool valid = false;
+    };
+    RenderCache m_renderCache;
+
+    bool isMetaGridCacheable() const;
+    bool isGridCacheable() const;
+    bool isRenderCacheMatching(RS_Painter *painter, LC_GraphicViewport *view, bool cacheMetaGrid, bool cacheGrid) const;
+    void doDraw(RS_Painter *painter, LC_GraphicViewport *view);
+
     void doCreateGrid(LC_GraphicViewport* view, const RS_Vector &viewZero, const RS_Vector &viewSize, const RS_Vector &metaGridWidth, const RS_Vector &gridWidth);
     virtual void createMetaGridLines(const RS_Vector& min, const RS_Vector &max)  = 0;
     void drawMetaGrid(RS_Painter *painter, LC_GraphicViewport *view);
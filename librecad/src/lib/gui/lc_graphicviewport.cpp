@@ -396,6 +396,19 @@ void LC_GraphicViewport::invalidateGrid() {
     grid->invalidate(isGridOn());
 }
 
+LC_GraphicViewportState LC_GraphicViewport::getState() const {
+    LC_GraphicViewportState result;
+    result.hasUcs = hasUCS();
+    result.ucsOrigin = getUcsOrigin();
+    result.xAxisAngle = getXAxisAngle();
+    result.factor = factor;
+    result.offsetX = offsetX;
+    result.offsetY = offsetY;
+    result.height = m_height;
+    result.panning = panning;
+    return result;
+}
+
 void LC_GraphicViewport::fireRedrawNeeded(){
     for (int i=0; i<viewportListeners.size(); ++i) {
         LC_GraphicViewPortListener* l = viewportListeners.at(i);
@@ -40,6 +40,21 @@ class QDateTime;
 class RS_Undoable;
 class LC_GraphicViewPortListener;
 
+/**
+ * Copy of the viewport state used for painting. Painters of worker threads get it from the gui thread,
+ * as the viewport may be changed while they paint.
+ */
+struct LC_GraphicViewportState {
+    bool hasUcs = false;
+    RS_Vector ucsOrigin{0., 0., 0.};
+    double xAxisAngle = 0.0;
+    RS_Vector factor{1., 1.};
+    int offsetX = 0;
+    int offsetY = 0;
+    int height = 0;
+    bool panning = false;
+};
+
 class LC_GraphicViewport: public LC_CoordinatesMapper{
 public:
     LC_GraphicViewport();
@@ -160,6 +175,7 @@ public:
     LC_OverlaysManager* getOverlaysManager() { return &overlaysManager;}
     bool isPanning() const {return panning;}
     void setPanning(bool state) {  panning = state;}
+    LC_GraphicViewportState getState() const;
     RS_Graphic* getGraphic() {return graphic;}
     void addViewportListener(LC_GraphicViewPortListener* listener);
     void removeViewportListener(LC_GraphicViewPortListener* listener);
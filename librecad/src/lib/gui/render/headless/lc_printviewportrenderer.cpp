@@ -23,6 +23,7 @@
 #include "lc_printviewportrenderer.h"
 
 #include "lc_graphicviewport.h"
+#include "lc_profiler.h"
 #include "rs_entitycontainer.h"
 #include "rs_math.h"
 #include "rs_painter.h"
@@ -40,30 +41,20 @@ LC_PrintViewportRenderer::LC_PrintViewportRenderer(LC_GraphicViewport *viewport,
 void LC_PrintViewportRenderer::doRender() {
     setupPainter(painter);
     RS_EntityContainer *container = viewport->getContainer();
+    beginLinesBatching();
     container->draw(painter);
+    endLinesBatching(painter);
 }
 
 
 void LC_PrintViewportRenderer::renderEntity(RS_Painter *painter, RS_Entity *e) {
-#ifdef DEBUG_RENDERING
-    isVisibleTimer.start();
-#endif
     // entity is not visible:
     bool visible = e->isVisible();
-#ifdef DEBUG_RENDERING
-    isVisibleTime += isVisibleTimer.nsecsElapsed();
-#endif
     if (!visible) {
         return;
     }
 
-#ifdef DEBUG_RENDERING
-    isConstructionTimer.start();
-#endif
     bool constructionEntity = e->isConstruction();
-#ifdef DEBUG_RENDERING
-    isConstructionTime += isConstructionTimer.nsecsElapsed();
-#endif
     // do not draw construction layer on print preview or print
     if (!e->isPrint() || constructionEntity)
         return;
@@ -76,9 +67,7 @@ void LC_PrintViewportRenderer::renderEntity(RS_Painter *painter, RS_Entity *e) {
 }
 
 void LC_PrintViewportRenderer::setPenForPrintingEntity(RS_Painter *painter, RS_Entity *e) {
-#ifdef DEBUG_RENDERING
-    setPenTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionSetPen);
     // Getting pen from entity (or layer)
     RS_Pen pen = e->getPenResolved();
     RS_Pen originalPen = pen;
@@ -149,9 +138,6 @@ void LC_PrintViewportRenderer::setPenForPrintingEntity(RS_Painter *painter, RS_E
     // we store original pen as last painted, not resolved one - since original pen lead to resulting resolved and may be used by the next entity
     lastPaintEntityPen.updateBy(originalPen);
     painter->setPen(pen);
-#ifdef DEBUG_RENDERING
-    setPenTime += setPenTimer.nsecsElapsed();
-#endif
 }
 
 
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_arctessellationcache.h"
+
+#include <cmath>
+#include <functional>
+
+bool LC_ArcTessellationCache::ShapeKey::operator==(const ShapeKey& other) const {
+    return type == other.type && radiusX == other.radiusX && radiusY == other.radiusY
+           && startAngle == other.startAngle && angularLength == other.angularLength;
+}
+
+size_t LC_ArcTessellationCache::ShapeKeyHash::operator()(const ShapeKey& key) const {
+    std::hash<double> hashDouble;
+    size_t result = static_cast<size_t>(key.type);
+    for (double value: {key.radiusX, key.radiusY, key.startAngle, key.angularLength}) {
+        result ^= hashDouble(value) + 0x9e3779b97f4a7c15ULL + (result << 6) + (result >> 2);
+    }
+    return result;
+}
+
+void LC_ArcTessellationCache::clear() {
+    m_shapes.clear();
+    m_unitCircles.clear();
+}
+
+/**
+ * Shapes are built for the UI size of arcs, so shapes of the previous zoom are not needed anymore.
+ */
+void LC_ArcTessellationCache::setViewFactor(double factor) {
+    if (factor != m_viewFactor) {
+        m_viewFactor = factor;
+        m_shapes.clear();
+    }
+}
+
+const QPainterPath* LC_ArcTessellationCache::findShape(const ShapeKey& key) const {
+    auto it = m_shapes.find(key);
+    return it == m_shapes.end() ? nullptr : &it->second;
+}
+
+const QPainterPath& LC_ArcTessellationCache::addShape(const ShapeKey& key, QPainterPath shape) {
+    if (m_shapes.size() >= MAX_SHAPES) {
+        m_shapes.clear();
+    }
+    return m_shapes.insert_or_assign(key, std::move(shape)).first->second;
+}
+
+/**
+ * Adds to the path full circle interpolated by given amount of line segments. Vertices are taken from the table
+ * for the unit circle, which is shared by all circles with the same amount of segments.
+ */
+void LC_ArcTessellationCache::addCircle(QPainterPath& path, double uiCenterX, double uiCenterY, double uiRadius,
+                                        int stepsCount) {
+    const std::vector<QPointF>& unitCircle = getUnitCircle(stepsCount);
+    const size_t count = unitCircle.size();
+    m_circlePoints.resize(static_cast<qsizetype>(count));
+    const QPointF* unit = unitCircle.data();
+    QPointF* points = m_circlePoints.data();
+    // plain scale and translate over contiguous arrays, so the compiler is free to vectorize it
+    for (size_t i = 0; i < count; i++) {
+        points[i] = QPointF(unit[i].x() * uiRadius + uiCenterX, unit[i].y() * uiRadius + uiCenterY);
+    }
+    path.addPolygon(m_circlePoints);
+}
+
+/**
+ * Vertices of the unit circle that starts at angle 0 and goes clockwise on the screen, as the y-axis of the
+ * painter is pointing downwards. The last vertex closes the circle.
+ */
+const std::vector<QPointF>& LC_ArcTessellationCache::getUnitCircle(int stepsCount) {
+    std::vector<QPointF>& unitCircle = m_unitCircles[stepsCount];
+    if (unitCircle.empty()) {
+        unitCircle.reserve(stepsCount + 1);
+        const double deltaAngle = 2. * M_PI / stepsCount;
+        for (int i = 0; i < stepsCount; i++) {
+            const double angle = deltaAngle * i;
+            unitCircle.emplace_back(std::cos(angle), -std::sin(angle));
+        }
+        unitCircle.emplace_back(1., 0.);
+    }
+    return unitCircle;
+}
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_ARCTESSELLATIONCACHE_H
+#define LC_ARCTESSELLATIONCACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <QPainterPath>
+#include <QPointF>
+#include <QPolygonF>
+
+/**
+ * Cache of arc and ellipse arc shapes, tessellated in UI coordinates. Shapes are built around the zero point,
+ * so they are reused while the view is panned, and for all arcs of the same size and angles. Shapes depend on
+ * the arc rendering settings of the painter, so the cache should be cleared when these settings change.
+ * The cache is not thread-safe, each renderer owns its own cache.
+ */
+class LC_ArcTessellationCache {
+public:
+    enum ShapeType {
+        ArcInterpolatedByLines,
+        ArcBySplinePoints,
+        EllipseArc
+    };
+
+    /**
+     * Size and angles of the shape in UI coordinates. As the key contains the geometry of the shape,
+     * changed entities never get stale shapes.
+     */
+    struct ShapeKey {
+        ShapeType type = ArcInterpolatedByLines;
+        double radiusX = 0.;
+        double radiusY = 0.;
+        double startAngle = 0.;
+        double angularLength = 0.;
+
+        bool operator==(const ShapeKey& other) const;
+    };
+
+    LC_ArcTessellationCache() = default;
+    void clear();
+    void setViewFactor(double factor);
+    const QPainterPath* findShape(const ShapeKey& key) const;
+    const QPainterPath& addShape(const ShapeKey& key, QPainterPath shape);
+    void addCircle(QPainterPath& path, double uiCenterX, double uiCenterY, double uiRadius, int stepsCount);
+private:
+    struct ShapeKeyHash {
+        size_t operator()(const ShapeKey& key) const;
+    };
+    // shapes are dropped all at once, as on zoom most of them become obsolete anyway
+    static constexpr size_t MAX_SHAPES = 50000;
+
+    const std::vector<QPointF>& getUnitCircle(int stepsCount);
+
+    double m_viewFactor = 0.;
+    std::unordered_map<ShapeKey, QPainterPath, ShapeKeyHash> m_shapes;
+    std::unordered_map<int, std::vector<QPointF>> m_unitCircles;
+    QPolygonF m_circlePoints;
+};
+
+#endif // LC_ARCTESSELLATIONCACHE_H
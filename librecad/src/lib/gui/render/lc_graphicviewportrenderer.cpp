@@ -25,9 +25,11 @@
 #include "lc_defaults.h"
 #include "lc_graphicviewport.h"
 #include "lc_linemath.h"
+#include "lc_profiler.h"
 #include "rs_entity.h"
 #include "rs_graphic.h"
 #include "rs_painter.h"
+#include "rs_settings.h"
 #include "rs_units.h"
 
 LC_GraphicViewportRenderer::LC_GraphicViewportRenderer(LC_GraphicViewport* v, QPaintDevice* painterDevice):
@@ -43,18 +45,15 @@ void LC_GraphicViewportRenderer::render() {
 }
 
 void LC_GraphicViewportRenderer::renderEntityAsChild(RS_Painter *painter, RS_Entity *e) {
-#ifdef DEBUG_RENDERING
-    drawEntityCount++;
-    drawTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionEntityDraw, LC_Profiler::isEnabled() ? e->rtti() : -1);
+    if (m_linesBatchingActive) {
+        painter->setLinesBatching(e->rtti() == RS2::EntityLine);
+    }
     e->drawAsChild(painter);
-#ifdef DEBUG_RENDERING
-    qint64 elapsed = drawTimer.nsecsElapsed();
-    entityDrawTime+= elapsed;
-#endif
 }
 
 void LC_GraphicViewportRenderer::loadSettings() {
+    m_batchLines = LC_GET_ONE_BOOL("Render", "BatchLines", true);
     auto g = getGraphic();
     if (g != nullptr){
         updateGraphicRelatedSettings(g);
@@ -62,10 +61,15 @@ void LC_GraphicViewportRenderer::loadSettings() {
 }
 
 LC_Rect LC_GraphicViewportRenderer::prepareBoundingClipRect(){
-    int width = viewport->getWidth();
-    int height = viewport->getHeight();
-    const RS_Vector ucsViewportLeftBottom = viewport->toUCSFromGui(0, 0);
-    const RS_Vector ucsViewportRightTop = viewport->toUCSFromGui(width, height);
+    return prepareBoundingClipRect(0, 0, viewport->getWidth(), viewport->getHeight());
+}
+
+/**
+ * Returns world rect that covers given rect in gui coordinates of the viewport.
+ */
+LC_Rect LC_GraphicViewportRenderer::prepareBoundingClipRect(int uiLeft, int uiTop, int uiRight, int uiBottom) const{
+    const RS_Vector ucsViewportLeftBottom = viewport->toUCSFromGui(uiLeft, uiTop);
+    const RS_Vector ucsViewportRightTop = viewport->toUCSFromGui(uiRight, uiBottom);
 
     if (viewport->hasUCS()){
         // here were extend (enlarge) clipping rect to ensure that if there is shift/rotation in ucs, resulting bounding box cover the entire screen
@@ -117,15 +121,25 @@ bool LC_GraphicViewportRenderer::isOutsideOfBoundingClipRect(RS_Entity* e, bool
  * The painter must be initialized and all the attributes (pen) must be set.
  */
 void LC_GraphicViewportRenderer::justDrawEntity(RS_Painter *painter, RS_Entity *e) {
-#ifdef DEBUG_RENDERING
-    drawEntityCount++;
-    drawTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionEntityDraw, LC_Profiler::isEnabled() ? e->rtti() : -1);
+    if (m_linesBatchingActive) {
+        // lines collected so far are drawn before any other entity, so the drawing order is kept
+        painter->setLinesBatching(e->rtti() == RS2::EntityLine);
+    }
     e->draw(painter);
-#ifdef DEBUG_RENDERING
-    qint64 elapsed = drawTimer.nsecsElapsed();
-    entityDrawTime+= elapsed;
-#endif
+}
+
+/**
+ * Enables batching of lines for entities drawn by justDrawEntity() and renderEntityAsChild() until
+ * endLinesBatching() is called.
+ */
+void LC_GraphicViewportRenderer::beginLinesBatching() {
+    m_linesBatchingActive = m_batchLines;
+}
+
+void LC_GraphicViewportRenderer::endLinesBatching(RS_Painter *painter) {
+    m_linesBatchingActive = false;
+    painter->setLinesBatching(false);
 }
 
 void LC_GraphicViewportRenderer::updateEndCapsStyle(const RS_Graphic *graphic) {//        Lineweight endcaps setting for new objects:
@@ -202,13 +216,22 @@ void LC_GraphicViewportRenderer::updateUnitAndDefaultWidthFactors(const RS_Graph
 
 void LC_GraphicViewportRenderer::setupPainter(RS_Painter *painter) {
     painter->setRenderer(this);
-    painter->setViewPort(viewport);
+    if (m_viewportState != nullptr) {
+        painter->setViewPort(viewport, *m_viewportState);
+    }
+    else {
+        painter->setViewPort(viewport);
+    }
     painter->updatePointsScreenSize(pdsize);
     painter->setPointsMode(pdmode);
     painter->setDefaultWidthFactor(defaultWidthFactor);
     painter->setWorldBoundingRect(renderBoundingClipRect);
 }
 
+bool LC_GraphicViewportRenderer::isViewportPanning() const {
+    return m_viewportState != nullptr ? m_viewportState->panning : viewport->isPanning();
+}
+
 bool LC_GraphicViewportRenderer::isTextLineNotRenderable([[maybe_unused]]double d) const {
     return false;
 }
@@ -27,15 +27,8 @@
 #include "rs_color.h"
 #include "rs_pen.h"
 
-#define DEBUG_RENDERING_
-
-#ifdef DEBUG_RENDERING
-#include <QElapsedTimer>
-
-#define DEBUG_RENDERING_DETAILS
-#endif
-
 class LC_GraphicViewport;
+struct LC_GraphicViewportState;
 class RS_Entity;
 class RS_Painter;
 class RS_Graphic;
@@ -65,6 +58,8 @@ class LC_GraphicViewportRenderer{
 protected:
     QPaintDevice* pd = nullptr;
     LC_GraphicViewport* viewport = nullptr;
+    // state of the viewport captured by the gui thread, used instead of the viewport while rendering in a worker thread
+    const LC_GraphicViewportState* m_viewportState = nullptr;
     RS_Graphic* graphic = nullptr;
 
     LC_Rect renderBoundingClipRect;
@@ -77,6 +72,7 @@ protected:
     RS_Pen lastPaintEntityPen = {};
 
     LC_Rect prepareBoundingClipRect();
+    LC_Rect prepareBoundingClipRect(int uiLeft, int uiTop, int uiRight, int uiBottom) const;
     virtual void doRender() = 0;
 
     // painting cached values
@@ -85,6 +81,9 @@ protected:
     double defaultWidthFactor = 1.0;
 
     bool m_scaleLineWidth = true;
+    // lines of consecutive line entities with the same pen are passed to the painter in batches
+    bool m_batchLines = true;
+    bool m_linesBatchingActive = false;
 
     Qt::PenJoinStyle penJoinStyle = Qt::RoundJoin;
     Qt::PenCapStyle penCapStyle = Qt::RoundCap;
@@ -103,27 +102,11 @@ protected:
     void updatePointEntitiesStyle(RS_Graphic *graphic);
     void updateUnitAndDefaultWidthFactors(const RS_Graphic *g);
     bool isOutsideOfBoundingClipRect(RS_Entity *e, bool constructionEntity);
+    void beginLinesBatching();
+    void endLinesBatching(RS_Painter *painter);
 
     RS_Graphic* getGraphic(){return graphic;}
-
-#ifdef DEBUG_RENDERING
-    QElapsedTimer drawTimer;
-    QElapsedTimer isVisibleTimer;
-    QElapsedTimer setPenTimer;
-    QElapsedTimer painterSetPenTimer;
-    QElapsedTimer getPenTimer;
-    QElapsedTimer isConstructionTimer;
-
-    // painting debug
-    int drawEntityCount = 1;
-    long long entityDrawTime = 0;
-    long long isVisibleTime = 0;
-    long long isConstructionTime = 0;
-    long long setPenTime = 0;
-    long long painterSetPenTime = 0;
-    long long getPenTime = 0;
-#endif
-
+    bool isViewportPanning() const;
 
     void updateAnglesBasis(RS_Graphic *g);
 };
@@ -25,8 +25,10 @@
 #include <QPainterPath>
 
 #include "dxf_format.h"
+#include "lc_arctessellationcache.h"
 #include "lc_graphicviewport.h"
 #include "lc_graphicviewportrenderer.h"
+#include "lc_imagecache.h"
 #include "lc_linemath.h"
 #include "lc_splinepoints.h"
 #include "rs_arc.h"
@@ -50,9 +52,12 @@ const RS_Color colorWhite = RS_Color(Qt::white);
 const QColor qcolorBlack = colorBlack.toQColor();
 const QColor qcolorWhite = colorWhite.toQColor();
 
+// maximum number of lines collected before they are drawn
+constexpr size_t LINES_BATCH_SIZE = 4096;
+
 // Convert from LibreCAD line style pattern to QPen Dash Pattern.
 // QPen dash pattern by default is in the unit of pixel
-    QVector<qreal> rsToQDashPattern(const RS2::LineType &t, double screenWidth, double dpmm, double &newDashOffset) {
+    QVector<qreal> rsToQDashPattern(const RS2::LineType &t, double screenWidth, double dpmm) {
         // dash pattern is in mm
         // d*dpmm/screenWidth, so, the scaling factor k = dpmm/screenWidth
         dpmm = std::max(dpmm, 1e-6);
@@ -64,11 +69,14 @@ const QColor qcolorWhite = colorWhite.toQColor();
             return std::max(k * std::abs(d), 1.);
         });
         dashPattern.resize(dashPattern.size() - dashPattern.size() % 2);
-
-        newDashOffset = newDashOffset * k;
         return dashPattern;
     }
 
+// Dash offset is scaled the same way as the pattern
+    double rsToQDashOffset(double dashOffset, double screenWidth, double dpmm) {
+        return dashOffset * std::max(dpmm, 1e-6) / std::max(screenWidth, 1.);
+    }
+
 /**
  * Wrapper for Qt
  * convert RS2::LineType to Qt::PenStyle
@@ -286,6 +294,18 @@ void RS_Painter::drawLineUISimple(double x1, double y1, double x2, double y2){
 
 void RS_Painter::drawLineUI(const QPointF& startPoint, const QPointF& endPoint)
 {
+    if (m_linesBatching && m_batchablePen) {
+        if((startPoint - endPoint).manhattanLength() > minLineDrawingLen) {
+            m_linesBatch.emplace_back(startPoint, endPoint);
+        }
+        else{
+            m_pointsBatch.push_back((startPoint + endPoint) * 0.5);
+        }
+        if (m_linesBatch.size() + m_pointsBatch.size() >= LINES_BATCH_SIZE) {
+            flushLines();
+        }
+        return;
+    }
     if((startPoint - endPoint).manhattanLength() > minLineDrawingLen) {
         QPainter::drawLine(startPoint, endPoint);
     }
@@ -299,6 +319,24 @@ void RS_Painter::drawLineUI(double x1, double y1, double x2, double y2)
     drawLineUI({x1, y1}, {x2, y2});
 }
 
+void RS_Painter::setLinesBatching(bool enable) {
+    if (!enable) {
+        flushLines();
+    }
+    m_linesBatching = enable;
+}
+
+void RS_Painter::flushLines() {
+    if (!m_linesBatch.empty()) {
+        QPainter::drawLines(m_linesBatch.data(), static_cast<int>(m_linesBatch.size()));
+        m_linesBatch.clear();
+    }
+    if (!m_pointsBatch.empty()) {
+        QPainter::drawPoints(m_pointsBatch.data(), static_cast<int>(m_pointsBatch.size()));
+        m_pointsBatch.clear();
+    }
+}
+
 #define DEBUG_ARC_RENDERING_NO
 
 
@@ -441,6 +479,24 @@ void RS_Painter::drawArcEntity(RS_Arc* arc, QPainterPath &path){
 
 void RS_Painter::drawArcSegmentBySplinePointsUI(
     const RS_Vector& uiCenter, double uiRadiusX, double startAngleRad, double angularLengthRad, QPainterPath &path) {
+    if (m_arcTessellationCache == nullptr) {
+        buildArcSegmentBySplinePointsUI(uiCenter, uiRadiusX, startAngleRad, angularLengthRad, path);
+        return;
+    }
+    // fitting of spline points is expensive, so the shape is reused for arcs of the same size and angles
+    const LC_ArcTessellationCache::ShapeKey key{LC_ArcTessellationCache::ArcBySplinePoints, uiRadiusX, uiRadiusX,
+                                                startAngleRad, angularLengthRad};
+    const QPainterPath* shape = m_arcTessellationCache->findShape(key);
+    if (shape == nullptr) {
+        QPainterPath shapePath;
+        buildArcSegmentBySplinePointsUI(RS_Vector{0., 0.}, uiRadiusX, startAngleRad, angularLengthRad, shapePath);
+        shape = &m_arcTessellationCache->addShape(key, std::move(shapePath));
+    }
+    path.addPath(shape->translated(uiCenter.x, uiCenter.y));
+}
+
+void RS_Painter::buildArcSegmentBySplinePointsUI(
+    const RS_Vector& uiCenter, double uiRadiusX, double startAngleRad, double angularLengthRad, QPainterPath &path) {
 // Issue #2035
 // Estimate the rendering error by using a quadratic bezier to render an arc. The bezier
 // curve(lc_splinepoints) is defined by a set of equidistant arc points
@@ -565,7 +621,28 @@ void RS_Painter::drawArcInterpolatedByLines(const RS_Vector& uiCenter, double ui
     // This is more precise drawing for arc's endpoints, yet in general slower(?) by performance.
     // Also, with too high allowed tolerance, arcs may be drawn not smoothly.
 
-    double angularLengthRad = RS_Math::deg2rad(angularLength);
+    const int stepsCount = getArcInterpolationStepsCount(uiRadiusX, RS_Math::deg2rad(angularLength));
+    if (m_arcTessellationCache == nullptr) {
+        buildArcInterpolatedByLines(uiCenter, uiRadiusX, uiStartAngleDegrees, angularLength, stepsCount, path);
+    }
+    else if (uiStartAngleDegrees == 0. && angularLength == 360.) {
+        // full circles are scaled from the shared unit circle
+        m_arcTessellationCache->addCircle(path, uiCenter.x, uiCenter.y, uiRadiusX, stepsCount);
+    }
+    else {
+        const LC_ArcTessellationCache::ShapeKey key{LC_ArcTessellationCache::ArcInterpolatedByLines, uiRadiusX, uiRadiusX,
+                                                    uiStartAngleDegrees, angularLength};
+        const QPainterPath* shape = m_arcTessellationCache->findShape(key);
+        if (shape == nullptr) {
+            QPainterPath shapePath;
+            buildArcInterpolatedByLines(RS_Vector{0., 0.}, uiRadiusX, uiStartAngleDegrees, angularLength, stepsCount, shapePath);
+            shape = &m_arcTessellationCache->addShape(key, std::move(shapePath));
+        }
+        path.addPath(shape->translated(uiCenter.x, uiCenter.y));
+    }
+}
+
+int RS_Painter::getArcInterpolationStepsCount(double uiRadiusX, double angularLengthRad) const {
     // actually, this is not only tolerance, but also arc's height (sagitta, https://en.wikipedia.org/wiki/Sagitta_(geometry))
     // sagitta will represent max distance between true arc and line chord that is used for interpolation
     // so, based on expected sagitta we'll calculate the angle for single line interpolation segment
@@ -586,6 +663,12 @@ void RS_Painter::drawArcInterpolatedByLines(const RS_Vector& uiCenter, double ui
         stepsCount = int(ceil(stepsTolerance)) + 2;
     }
 //        LC_ERR << "ARC steps: " << stepsTol <<  " " << steps << " len " << angularLength << " start " << uiStartAngleDegrees;
+    return stepsCount;
+}
+
+void RS_Painter::buildArcInterpolatedByLines(const RS_Vector& uiCenter, double uiRadiusX, double uiStartAngleDegrees,
+                                             double angularLength, int stepsCount, QPainterPath &path) const {
+    double angularLengthRad = RS_Math::deg2rad(angularLength);
     double uiStartAngleRad = RS_Math::deg2rad(uiStartAngleDegrees);
 
     double deltaAngleRad = angularLengthRad / stepsCount;
@@ -732,10 +815,25 @@ void RS_Painter::drawEllipseArcUI(const RS_Vector& uiCenter, const RS_Vector& ui
             angle1Degrees = angle2Degrees - 360.;
             angularLength = -angularLength;
         }
-        QPainterPath path;
-        path.arcMoveTo(minPosition.x, minPosition.y, uiSize.x, uiSize.y, angle1Degrees);
-        path.arcTo(minPosition.x, minPosition.y, uiSize.x, uiSize.y, angle1Degrees, angularLength);
-        QPainter::drawPath(path);
+        if (m_arcTessellationCache == nullptr) {
+            QPainterPath path;
+            path.arcMoveTo(minPosition.x, minPosition.y, uiSize.x, uiSize.y, angle1Degrees);
+            path.arcTo(minPosition.x, minPosition.y, uiSize.x, uiSize.y, angle1Degrees, angularLength);
+            QPainter::drawPath(path);
+        }
+        else {
+            // the shape is in the coordinates of the ellipse, so it's reused as is
+            const LC_ArcTessellationCache::ShapeKey key{LC_ArcTessellationCache::EllipseArc, uiRadii.x, uiRadii.y,
+                                                        angle1Degrees, angularLength};
+            const QPainterPath* shape = m_arcTessellationCache->findShape(key);
+            if (shape == nullptr) {
+                QPainterPath shapePath;
+                shapePath.arcMoveTo(minPosition.x, minPosition.y, uiSize.x, uiSize.y, angle1Degrees);
+                shapePath.arcTo(minPosition.x, minPosition.y, uiSize.x, uiSize.y, angle1Degrees, angularLength);
+                shape = &m_arcTessellationCache->addShape(key, std::move(shapePath));
+            }
+            QPainter::drawPath(*shape);
+        }
     }
 }
 
@@ -971,7 +1069,7 @@ void RS_Painter::drawSplineWCS(const RS_Spline& spline){
     QPainter::drawPath(path);
 }
 
-void RS_Painter::drawImgWCS(QImage& img, const RS_Vector& wcsInsertionPoint,
+void RS_Painter::drawImgWCS(LC_CachedImage& img, const RS_Vector& wcsInsertionPoint,
                            const RS_Vector& uVector, const RS_Vector& vVector) {
 
 //    if (viewport->hasUCS()) {
@@ -991,10 +1089,14 @@ void RS_Painter::drawImgWCS(QImage& img, const RS_Vector& wcsInsertionPoint,
     double magnitudeV = vVector.magnitude(); // fixme - sand - render - cache?
     RS_Vector scale{toGuiDX(magnitudeU),toGuiDY(magnitudeV)};
     const RS_Vector uiInsert = toGui(wcsInsertionPoint);
-    drawImgUI(img, uiInsert, ucsUVector, ucsVVector, scale);
+
+    // at zoomed out views, use downscaled level of the image instead of sampling full resolution one
+    int levelFactor = 1;
+    QImage level = img.getLevel(std::max(std::abs(scale.x), std::abs(scale.y)), levelFactor);
+    drawImgUI(level, uiInsert, ucsUVector, ucsVVector, scale * levelFactor);
 }
 
-void RS_Painter::drawImgUI(QImage& img, const RS_Vector& uiInsert,
+void RS_Painter::drawImgUI(const QImage& img, const RS_Vector& uiInsert,
                            const RS_Vector& uVector, const RS_Vector& vVector, const RS_Vector& factor) {
     PainterGuard painterGuard(*this);
 
@@ -1021,9 +1123,22 @@ void RS_Painter::drawImgUI(QImage& img, const RS_Vector& uiInsert,
     }
 
     wm->scale(factor.x, factor.y);
-    setWorldTransform(*wm);
-
-    drawImage(0,-img.height(), img);
+    setWorldTransform(*wm, true);
+
+    // sample only the part of the image that is within the device, zoomed in large images are mostly outside
+    QRectF imageRect(0, -img.height(), img.width(), img.height());
+    bool invertible = false;
+    QTransform toImage = combinedTransform().inverted(&invertible);
+    if (invertible) {
+        QRectF visible = toImage.mapRect(QRectF(QPainter::viewport())).adjusted(-1, -1, 1, 1).intersected(imageRect);
+        if (visible.isEmpty()) {
+            return;
+        }
+        QRect source = visible.translated(0, img.height()).toAlignedRect().intersected(img.rect());
+        drawImage(QRectF(source).translated(0, -img.height()), img, source);
+    } else {
+        drawImage(0,-img.height(), img);
+    }
 }
 
 void RS_Painter::drawTextH(int x1, int y1,
@@ -1113,6 +1228,7 @@ RS_Pen RS_Painter::getPen() const{
 }
 
 void RS_Painter::noCapStyle(){
+    flushLines();
     QPen pen = QPainter::pen();
     pen.setCapStyle(Qt::PenCapStyle::FlatCap);
     QPainter::setPen(pen);
@@ -1141,21 +1257,19 @@ void RS_Painter::setPen(const RS_Pen& pen) {
 
     double screenWidth = pen.getScreenWidth();
     if (style == Qt::CustomDashLine){
-        double newDashOffset = pen.dashOffset();
-        auto dashPattern = rsToQDashPattern(lineType,
-                                            screenWidth/*p.widthF()*/,
-                                            getDpmmCached(),
-                                            newDashOffset);
+        const QVector<qreal>& dashPattern = getDashPattern(lineType, screenWidth/*p.widthF()*/, getDpmmCached());
         if (dashPattern.isEmpty()) {
             style = Qt::SolidLine;
         } else {
             QPen p(pColor, screenWidth, style);
-            p.setDashPattern(std::move(dashPattern));
+            p.setDashPattern(dashPattern);
             // fixme - how this is related to RS_AtomicEntity::updateDashOffset??? Will we set dash offset twice?
-            p.setDashOffset(newDashOffset);
+            p.setDashOffset(rsToQDashOffset(pen.dashOffset(), screenWidth, getDpmmCached()));
             p.setJoinStyle(penJoinStyle);
             p.setCapStyle(penCapStyle);
             lastUsedPen = p;
+            flushLines();
+            m_batchablePen = false;
             QPainter::setPen(p);
             return;
         }
@@ -1179,11 +1293,24 @@ void RS_Painter::setPen(const RS_Pen& pen) {
     lastUsedPen.setCapStyle(penCapStyle);
 
     if (changed){
+        flushLines();
         QPainter::setPen(lastUsedPen);
     }
+    m_batchablePen = style == Qt::SolidLine;
+}
+
+const QVector<qreal>& RS_Painter::getDashPattern(RS2::LineType lineType, double screenWidth, double dpmm) {
+    auto key = std::make_tuple(static_cast<int>(lineType), screenWidth, dpmm);
+    auto it = m_dashPatterns.find(key);
+    if (it == m_dashPatterns.end()) {
+        it = m_dashPatterns.emplace(key, rsToQDashPattern(lineType, screenWidth, dpmm)).first;
+    }
+    return it->second;
 }
 
 void RS_Painter::setPen(const RS_Color& color) {
+    flushLines();
+    m_batchablePen = true;
     switch (drawingMode) {
         case RS2::ModeBW: {
             const RS_Color &color = RS_Color(Qt::black);
@@ -1205,6 +1332,8 @@ void RS_Painter::setPen(const RS_Color& color) {
 }
 
 void RS_Painter::setPen(int r, int g, int b) {
+    flushLines();
+    m_batchablePen = true;
     switch (drawingMode) {
         case RS2::ModeBW: {
             RS_Color color = RS_Color(Qt::black);
@@ -1228,6 +1357,8 @@ void RS_Painter::setPen(int r, int g, int b) {
 }
 
 void RS_Painter::disablePen() {
+    flushLines();
+    m_batchablePen = false;
     lpen = RS_Pen(RS2::FlagInvalid);
     QPainter::setPen(Qt::NoPen);
 }
@@ -1326,6 +1457,60 @@ void RS_Painter::setMinLineDrawingLen(double val) {
     minLineDrawingLen = val;
 }
 
+void RS_Painter::setLevelOfDetail(double pointSizePx, double proxySizePx) {
+    m_lodPointSize = pointSizePx;
+    m_lodProxySize = proxySizePx;
+}
+
+bool RS_Painter::isLevelOfDetailProxy(const RS_Entity* e) const {
+    if (m_lodPointSize <= 0. && m_lodProxySize <= 0.) {
+        return false;
+    }
+    switch (e->rtti()) {
+        // points have own screen size, construction lines are infinite
+        case RS2::EntityPoint:
+        case RS2::EntityConstructionLine:
+            return false;
+        default:
+            break;
+    }
+    const RS_Vector size = e->getSize();
+    if (size.x < 0. || size.y < 0.) {
+        // empty container, nothing to draw anyway
+        return false;
+    }
+    const double uiExtent = toGuiDX(std::max(size.x, size.y));
+    if (uiExtent < m_lodPointSize) {
+        return true;
+    }
+    return e->isContainer() && uiExtent < m_lodProxySize;
+}
+
+void RS_Painter::drawLevelOfDetailProxy(const RS_Entity* e) {
+    flushLines();
+    const RS_Vector wcsMin = e->getMin();
+    const RS_Vector wcsMax = e->getMax();
+    const RS_Vector size = wcsMax - wcsMin;
+    const double uiWidth = toGuiDX(size.x);
+    const double uiHeight = toGuiDY(size.y);
+    if (std::max(uiWidth, uiHeight) < m_lodPointSize) {
+        QPainter::drawPoint(toGuiPointF((wcsMin + wcsMax) * 0.5));
+    }
+    else if (uiWidth < 1. || uiHeight < 1.) {
+        QPainter::drawLine(toGuiPointF(wcsMin), toGuiPointF(wcsMax));
+    }
+    else {
+        const QPointF box[5] = {
+            toGuiPointF(wcsMin),
+            toGuiPointF(RS_Vector(wcsMax.x, wcsMin.y)),
+            toGuiPointF(wcsMax),
+            toGuiPointF(RS_Vector(wcsMin.x, wcsMax.y)),
+            toGuiPointF(wcsMin)
+        };
+        QPainter::drawPolyline(box, 5);
+    }
+}
+
 void RS_Painter::drawRectUI(double  uiX1, double  uiY1, double  uiX2, double  uiY2) {
     drawPolygon(QRect(int(uiX1 + 0.5), int(uiY1 + 0.5), int(uiX2 - uiX1 + 0.5), int(uiY2 - uiY1 + 0.5)));
 }
@@ -1354,7 +1539,7 @@ void RS_Painter::updateDashOffset(RS_Entity *e) {
 }
 
 int RS_Painter::determinePointScreenSize(double pdsize) const{
-    int deviceHeight = getHeight();
+    int deviceHeight = m_paintingTile ? static_cast<int>(viewPortHeight) : getHeight();
     if (!std::isnormal(pdsize)){
         int screenPointSize = deviceHeight / 20;
         return screenPointSize;
@@ -1437,13 +1622,32 @@ bool RS_Painter::isTextLineNotRenderable(double wcsLineHeight) const {
 }
 
 void RS_Painter::setViewPort(LC_GraphicViewport *v) {
+    setViewPort(v, v->getState());
+}
+
+/**
+ * Sets the viewport with its state captured before, so the painter doesn't read the viewport itself.
+ * That's used by painters of worker threads, while the gui thread may change the viewport.
+ */
+void RS_Painter::setViewPort(LC_GraphicViewport *v, const LC_GraphicViewportState& state) {
     viewport = v;
-    apply(viewport);
-    m_viewPortFactor = v->getFactor();
-    viewPortOffsetX = v->getOffsetX();
-    viewPortOffsetY = v->getOffsetY();
+    useUCS(state.hasUcs);
+    update(state.ucsOrigin, state.xAxisAngle);
+    m_viewPortFactor = state.factor;
+    viewPortOffsetX = state.offsetX;
+    viewPortOffsetY = state.offsetY;
     m_viewPortOffset.set(viewPortOffsetX, viewPortOffsetY);
-    viewPortHeight = v->getHeight();
+    viewPortHeight = state.height;
+}
+
+/**
+ * Prepares the painter for drawing into the device that holds only a part (tile) of the viewport.
+ * The gui point (uiLeft, uiTop) of the viewport is mapped to the top left corner of the device.
+ * Should be called before the viewport is set, so sizes that depend on the viewport height are calculated properly.
+ */
+void RS_Painter::setViewPortTileOrigin(int uiLeft, int uiTop) {
+    translate(-uiLeft, -uiTop);
+    m_paintingTile = true;
 }
 
 // NOTE:
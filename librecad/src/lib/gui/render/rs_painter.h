@@ -28,6 +28,10 @@
 #ifndef RS_PAINTER_H
 #define RS_PAINTER_H
 
+#include <map>
+#include <tuple>
+#include <vector>
+
 #include <QPainter>
 
 #include "lc_coordinates_mapper.h"
@@ -53,7 +57,10 @@ class QImage;
 class QBrush;
 class QString;
 
+class LC_ArcTessellationCache;
+class LC_CachedImage;
 class LC_GraphicViewport;
+struct LC_GraphicViewportState;
 class LC_GraphicViewportRenderer;
 
 struct LC_SplinePointsData;
@@ -100,7 +107,16 @@ public:
         return viewport;
     }
     void setViewPort(LC_GraphicViewport* v);
+    void setViewPort(LC_GraphicViewport* v, const LC_GraphicViewportState& state);
+    void setViewPortTileOrigin(int uiLeft, int uiTop);
     void setRenderer(LC_GraphicViewportRenderer *r) {renderer = r;}
+    /**
+     * While enabled, lines are collected and drawn by a single call on flush, instead of one call per line.
+     * Collected lines are flushed on disabling and on change of the pen, so the caller must disable batching
+     * before drawing anything that is not a line with the current pen.
+     */
+    void setLinesBatching(bool enable);
+    void flushLines();
     void updateDashOffset(RS_Entity* e);
     void clearDashOffset() {currenPatternOffset = 0.0;}
     double currentDashOffset() const {return currenPatternOffset;}
@@ -130,7 +146,7 @@ public:
     void drawLineWCS(const RS_Vector &wcsP1, const RS_Vector &wcP2);
     void drawPolylineWCS(const RS_Polyline *polyline);
     void drawHandleWCS(const RS_Vector &wcsPosition, const RS_Color &c, int size = -1);
-    void drawImgWCS(QImage &img, const RS_Vector &wcsInsertionPoint, const RS_Vector &uVector, const RS_Vector &vVector);
+    void drawImgWCS(LC_CachedImage &img, const RS_Vector &wcsInsertionPoint, const RS_Vector &uVector, const RS_Vector &vVector);
 
     // drawing in screen coordinates
     void drawCircleUI(const RS_Vector& uiCenter, double uiRadius);
@@ -213,6 +229,14 @@ public:
     void setMinEllipseMajorRadius(double minEllipseMajorRadius);
     void setMinEllipseMinorRadius(double minEllipseMinorRadius);
     void setMinLineDrawingLen(double minLineDrawingLen);
+    /**
+     * Level of detail: entities smaller on the screen than pointSizePx are drawn as a single point, containers smaller
+     * than proxySizePx are drawn as the box of their borders (or as a line, if the box is degenerated) without drawing
+     * of their children. Zero size disables the corresponding proxy.
+     */
+    void setLevelOfDetail(double pointSizePx, double proxySizePx);
+    bool isLevelOfDetailProxy(const RS_Entity* e) const;
+    void drawLevelOfDetailProxy(const RS_Entity* e);
     void setMinRenderableTextHeightInPx(int i);
     void setDefaultWidthFactor(double factor){ defaultWidthFactor = factor;}
     void updatePointsScreenSize(double pdSize);
@@ -224,6 +248,8 @@ public:
     void setRenderArcsInterpolationAngleValue(double val) {arcRenderInterpolationAngleValue = val;}
     void setRenderArcsInterpolationMaxSagitta(double val) {arcRenderInterpolationMaxSagitta = val;}
     void setRenderCirclesSameAsArcs(bool val) {circleRenderSameAsArcs = val;}
+    /** Arc shapes are reused from the cache, if set. The cache must match arc rendering settings of the painter. */
+    void setArcTessellationCache(LC_ArcTessellationCache* cache) {m_arcTessellationCache = cache;}
 
     void disableUCS();
 
@@ -267,17 +293,27 @@ protected:
     Qt::PenJoinStyle penJoinStyle = Qt::RoundJoin;
     Qt::PenCapStyle penCapStyle = Qt::RoundCap;
     QPen lastUsedPen;
+    // current pen is solid, so lines drawn by it may be collected into one batch
+    bool m_batchablePen = false;
+    bool m_linesBatching = false;
+    std::vector<QLineF> m_linesBatch;
+    std::vector<QPointF> m_pointsBatch;
+    // dash patterns in pixels by line type, screen width and dpmm
+    std::map<std::tuple<int, double, double>, QVector<qreal>> m_dashPatterns;
     double cachedDpmm = 0.;
     double minCircleDrawingRadius = 2.0;
     double minArcDrawingRadius = 0.8;
     double minEllipseMajorRadius = 2.;
     double minEllipseMinorRadius = 1.;
     double minLineDrawingLen = 2;
+    double m_lodPointSize = 0.;
+    double m_lodProxySize = 0.;
     bool arcRenderInterpolate = false;
     bool arcRenderInterpolationAngleFixed = false;
     double arcRenderInterpolationAngleValue = M_PI/36;
     double arcRenderInterpolationMaxSagitta = 0.9;
     bool circleRenderSameAsArcs = false;
+    LC_ArcTessellationCache* m_arcTessellationCache = nullptr;
 
     double minRenderableTextHeightInPx = 1;
     double defaultWidthFactor = 1.0;
@@ -295,6 +331,8 @@ protected:
     int viewPortOffsetY = 0;
     RS_Vector m_viewPortOffset;
     double viewPortHeight = 0.0;
+    // painting device is a tile of the viewport rather than entire viewport
+    bool m_paintingTile = false;
 
     LC_Rect wcsBoundingRect;
 
@@ -304,6 +342,7 @@ protected:
 //    void drawPolygonF(const QPolygonF &a, Qt::FillRule rule);
     void debugOutPath(const QPainterPath &tmpPath) const;
     double getDpmmCached() const {return cachedDpmm;}
+    const QVector<qreal>& getDashPattern(RS2::LineType lineType, double screenWidth, double dpmm);
 
     void drawArcEntity(RS_Arc* arc, QPainterPath &path);
 
@@ -322,7 +361,7 @@ protected:
                  double uiStartAngleDegrees, double angularLength, QPainterPath &path) const;
     void drawLineUI(double x1, double y1, double x2, double y2);
     void drawLineUI(const QPointF& startPoint, const QPointF& endPoint);
-    void drawImgUI(QImage& img, const RS_Vector& uiInsert, const RS_Vector& uVector, const RS_Vector& vVector, const RS_Vector& factor);
+    void drawImgUI(const QImage& img, const RS_Vector& uiInsert, const RS_Vector& uVector, const RS_Vector& vVector, const RS_Vector& factor);
 
     void drawRectUI(const RS_Vector& p1, const RS_Vector& p2);
 
@@ -338,12 +377,17 @@ protected:
 
     void drawArcInterpolatedByLines(const RS_Vector& uiCenter, double uiRadiusX, double uiStartAngleDegrees,
                                     double angularLength, QPainterPath &path) const;
+    void buildArcInterpolatedByLines(const RS_Vector& uiCenter, double uiRadiusX, double uiStartAngleDegrees,
+                                     double angularLength, int stepsCount, QPainterPath &path) const;
+    int getArcInterpolationStepsCount(double uiRadiusX, double angularLengthRad) const;
 
     void drawArcQT(const RS_Vector& uiCenter, const RS_Vector& uiRadii, double uiStartAngleDegrees,
                    double angularLength, QPainterPath &path);
 
     void drawArcSegmentBySplinePointsUI(const RS_Vector& center, double uiRadiusX, double uiStartAngleDegrees,
                                         double angularLength, QPainterPath &path);
+    void buildArcSegmentBySplinePointsUI(const RS_Vector& uiCenter, double uiRadiusX, double startAngleRad,
+                                         double angularLengthRad, QPainterPath &path);
 };
 
 #endif
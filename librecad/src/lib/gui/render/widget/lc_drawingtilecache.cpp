@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_drawingtilecache.h"
+
+#include <QPainter>
+
+bool LC_DrawingTilesViewState::operator==(const LC_DrawingTilesViewState& other) const {
+    return factorX == other.factorX && factorY == other.factorY && hasUcs == other.hasUcs
+           && ucsOriginX == other.ucsOriginX && ucsOriginY == other.ucsOriginY && xAxisAngle == other.xAxisAngle
+           && renderingFlags == other.renderingFlags;
+}
+
+void LC_DrawingTileCache::clear() {
+    m_tiles.clear();
+}
+
+/**
+ * Tiles are rendered for specific zoom, ucs and rendering mode, so any change of them makes all tiles obsolete.
+ * Returns true if the state was changed.
+ */
+bool LC_DrawingTileCache::setViewState(const LC_DrawingTilesViewState& state) {
+    if (state != m_viewState) {
+        m_viewState = state;
+        m_tiles.clear();
+        return true;
+    }
+    return false;
+}
+
+int LC_DrawingTileCache::floorDiv(int value, int divisor) {
+    int result = value / divisor;
+    if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+        result--;
+    }
+    return result;
+}
+
+/**
+ * Updates the range of visible tiles. Tiles that are far from the viewport are dropped, while the ring of tiles
+ * around the visible area is kept for subsequent small pans.
+ */
+void LC_DrawingTileCache::setViewport(int width, int height, int offsetX, int offsetY) {
+    m_viewportHeight = height;
+    m_offsetX = offsetX;
+    m_offsetY = offsetY;
+
+    m_columnMin = floorDiv(-offsetX, TILE_SIZE);
+    m_columnMax = floorDiv(width - 1 - offsetX, TILE_SIZE);
+    m_rowMin = floorDiv(offsetY - height, TILE_SIZE);
+    m_rowMax = floorDiv(offsetY - 1, TILE_SIZE);
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        int column = static_cast<int>(it->first >> 32);
+        int row = static_cast<int>(static_cast<unsigned int>(it->first & 0xffffffffLL));
+        if (column < m_columnMin - 1 || column > m_columnMax + 1 || row < m_rowMin - 1 || row > m_rowMax + 1) {
+            it = m_tiles.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+std::vector<QPoint> LC_DrawingTileCache::getMissingTiles() const {
+    std::vector<QPoint> result;
+    for (int row = m_rowMin; row <= m_rowMax; row++) {
+        for (int column = m_columnMin; column <= m_columnMax; column++) {
+            if (m_tiles.count(tileKey(column, row)) == 0) {
+                result.emplace_back(column, row);
+            }
+        }
+    }
+    return result;
+}
+
+QPoint LC_DrawingTileCache::getTileGuiOrigin(const QPoint& tile) const {
+    return {tile.x() * TILE_SIZE + m_offsetX, tile.y() * TILE_SIZE + m_viewportHeight - m_offsetY};
+}
+
+void LC_DrawingTileCache::setTile(const QPoint& tile, QImage image) {
+    m_tiles[tileKey(tile.x(), tile.y())] = std::move(image);
+}
+
+void LC_DrawingTileCache::draw(QPainter* painter) const {
+    for (int row = m_rowMin; row <= m_rowMax; row++) {
+        for (int column = m_columnMin; column <= m_columnMax; column++) {
+            auto it = m_tiles.find(tileKey(column, row));
+            if (it != m_tiles.end()) {
+                painter->drawImage(getTileGuiOrigin(QPoint(column, row)), it->second);
+            }
+        }
+    }
+}
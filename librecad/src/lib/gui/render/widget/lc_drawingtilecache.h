@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_DRAWINGTILECACHE_H
+#define LC_DRAWINGTILECACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <QImage>
+#include <QPoint>
+
+class QPainter;
+
+/**
+ * State of the view that affects content of rendered tiles. Offsets of the viewport are not part of the state,
+ * as tiles are anchored to the drawing and are simply moved on the screen as the viewport is panned.
+ */
+struct LC_DrawingTilesViewState {
+    double factorX = 0.0;
+    double factorY = 0.0;
+    bool hasUcs = false;
+    double ucsOriginX = 0.0;
+    double ucsOriginY = 0.0;
+    double xAxisAngle = 0.0;
+    int renderingFlags = 0;
+
+    bool operator==(const LC_DrawingTilesViewState& other) const;
+    bool operator!=(const LC_DrawingTilesViewState& other) const {return !(*this == other);}
+};
+
+/**
+ * Cache of rendered tiles of the drawing layer. Tile (column, row) covers the square of TILE_SIZE pixels that starts at
+ * (column*TILE_SIZE, row*TILE_SIZE) in coordinates that are relative to the gui position of the UCS zero, so the
+ * tile stays valid while the viewport is panned and only tiles that become exposed should be rendered.
+ */
+class LC_DrawingTileCache {
+public:
+    static constexpr int TILE_SIZE = 256;
+
+    LC_DrawingTileCache() = default;
+    void clear();
+    bool setViewState(const LC_DrawingTilesViewState& state);
+    void setViewport(int width, int height, int offsetX, int offsetY);
+    std::vector<QPoint> getMissingTiles() const;
+    QPoint getTileGuiOrigin(const QPoint& tile) const;
+    void setTile(const QPoint& tile, QImage image);
+    void draw(QPainter* painter) const;
+private:
+    static unsigned long long tileKey(int column, int row) {
+        // shifted as unsigned, shifting of negative signed values is undefined
+        return (static_cast<unsigned long long>(static_cast<unsigned int>(column)) << 32) | static_cast<unsigned int>(row);
+    }
+    static int floorDiv(int value, int divisor);
+
+    LC_DrawingTilesViewState m_viewState;
+    std::unordered_map<unsigned long long, QImage> m_tiles;
+
+    int m_viewportHeight = 0;
+    int m_offsetX = 0;
+    int m_offsetY = 0;
+
+    int m_columnMin = 0;
+    int m_columnMax = -1;
+    int m_rowMin = 0;
+    int m_rowMax = -1;
+};
+
+#endif // LC_DRAWINGTILECACHE_H
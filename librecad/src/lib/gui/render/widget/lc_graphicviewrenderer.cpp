@@ -30,6 +30,7 @@
 #include "rs_settings.h"
 #include "lc_overlayentitiescontainer.h"
 #include "lc_linemath.h"
+#include "lc_profiler.h"
 #include "rs_entity.h"
 #include "rs_entitycontainer.h"
 
@@ -89,37 +90,51 @@ void LC_GraphicViewRenderer::loadSettings() {
 }
 
 
+std::unique_ptr<LC_WidgetViewPortRenderer> LC_GraphicViewRenderer::createTileRenderer() {
+    auto result = std::make_unique<LC_GraphicViewRenderer>(viewport, nullptr);
+    result->loadSettings();
+    return result;
+}
+
+void LC_GraphicViewRenderer::syncTileRenderer(LC_WidgetViewPortRenderer *tileRenderer) {
+    LC_WidgetViewPortRenderer::syncTileRenderer(tileRenderer);
+    static_cast<LC_GraphicViewRenderer*>(tileRenderer)->setDraftMode(m_draftMode);
+}
+
+int LC_GraphicViewRenderer::getTileRenderingFlags() const {
+    return LC_WidgetViewPortRenderer::getTileRenderingFlags() | (m_draftMode ? 4 : 0) | (viewport->isPanning() ? 8 : 0);
+}
+
 void LC_GraphicViewRenderer::renderEntity(RS_Painter *painter, RS_Entity *e) {
+    if (isTileFrameOutdated()) {
+        // the tile won't be shown, so remaining entities are skipped
+        return;
+    }
     // check for selected entity drawing
     if (/*!e->isContainer() && */(e->getFlag(RS2::FlagSelected) != painter->shouldDrawSelected())) {
         return;
     }
-#ifdef DEBUG_RENDERING
-    isVisibleTimer.start();
-#endif
     // entity is not visible:
     bool visible = e->isVisible();
-#ifdef DEBUG_RENDERING
-    isVisibleTime += isVisibleTimer.nsecsElapsed();
-#endif
     if (!visible) {
         return;
     }
 
-#ifdef DEBUG_RENDERING
-    isConstructionTimer.start();
-#endif
     bool constructionEntity = e->isConstruction();
-#ifdef DEBUG_RENDERING
-    isConstructionTime += isConstructionTimer.nsecsElapsed();
-#endif
 
     if (isOutsideOfBoundingClipRect(e, constructionEntity)) {
         return;
     }
 
     RS2::EntityType entityType = e->rtti();
-    if (isDraftMode()) {
+    if (!constructionEntity && painter->isLevelOfDetailProxy(e)) {
+        // too small on the screen, so the entity is replaced by a proxy and containers are not traversed
+        if (!isDraftMode() || entityType != RS2::EntityHatch) {
+            setPenForDraftEntity(painter, e, false);
+            painter->drawLevelOfDetailProxy(e);
+        }
+    }
+    else if (isDraftMode()) {
         switch (entityType) {
             case RS2::EntityMText:
             case RS2::EntityText:
@@ -139,7 +154,7 @@ void LC_GraphicViewRenderer::renderEntity(RS_Painter *painter, RS_Entity *e) {
     else {
         // the code below is ugly as code for normal painting is duplicated.
         // however, it's intentional and made for perfromance reasons - to avoid additional checks or method calls during painting
-        if (viewport->isPanning()) {
+        if (isViewportPanning()) {
             switch (entityType) {
                 case RS2::EntityMText:
                 case RS2::EntityText:
@@ -300,6 +315,8 @@ void LC_GraphicViewRenderer::drawOverlayEntitiesInOverlay(LC_OverlaysManager *ov
 }
 
 void LC_GraphicViewRenderer::drawEntityReferencePoints(RS_Painter *painter, const RS_Entity *e) const {
+    // handles are drawn over the entity
+    painter->flushLines();
     RS_VectorSolutions const &s = e->getRefPoints();
     int sz = m_entityHandleHalfSize;
     size_t refsCount = s.getNumber();
@@ -378,14 +395,9 @@ void LC_GraphicViewRenderer::setPenForOverlayEntity(RS_Painter *painter, RS_Enti
 }
 
 void LC_GraphicViewRenderer::setPenForEntity(RS_Painter *painter, RS_Entity *e, bool inOverlay) {
-#ifdef DEBUG_RENDERING
-    getPenTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionSetPen);
     // Getting pen from entity (or layer)
     RS_Pen pen = e->getPenResolved();
-#ifdef DEBUG_RENDERING
-    getPenTime += getPenTimer.nsecsElapsed();
-#endif
     RS_Pen originalPen = pen;
     bool highlighted = e->getFlag(RS2::FlagHighlighted);
     bool selected = e->getFlag(RS2::FlagSelected);
@@ -405,9 +417,6 @@ void LC_GraphicViewRenderer::setPenForEntity(RS_Painter *painter, RS_Entity *e,
         m_lastPaintOverlay = overlayPaint;
     }
 
-#ifdef DEBUG_RENDERING
-    setPenTimer.start();
-#endif
     // Avoid negative widths
 //    int w = std::max(static_cast<int>(pen.getWidth()), 0);
     double width = pen.getWidth();
@@ -479,22 +488,12 @@ void LC_GraphicViewRenderer::setPenForEntity(RS_Painter *painter, RS_Entity *e,
     // deleting not drawing:
 
 // LC_ERR << "PEN " << pen.getColor().name() << "Width: " << pen.getWidth() <<  " | " << pen.getScreenWidth() << " LT " << pen.getLineType();
-#ifdef DEBUG_RENDERING
-    setPenTime += setPenTimer.nsecsElapsed();
-    painterSetPenTimer.start();
-#endif
     lastPaintEntityPen.updateBy(originalPen);
     painter->setPen(pen);
-#ifdef DEBUG_RENDERING
-    painterSetPenTime +=painterSetPenTimer.nsecsElapsed();
-
-#endif
 }
 
 void LC_GraphicViewRenderer::setPenForDraftEntity(RS_Painter *painter, RS_Entity *e, bool inOverlay) {
-#ifdef DEBUG_RENDERING
-    setPenTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionSetPen);
     RS_Pen pen = e->getPenResolved();
     RS_Pen originalPen = pen;
     bool highlighted = e->getFlag(RS2::FlagHighlighted);
@@ -554,9 +553,6 @@ void LC_GraphicViewRenderer::setPenForDraftEntity(RS_Painter *painter, RS_Entity
 // LC_ERR << "PEN " << pen.getColor().name() << "Width: " << pen.getWidth() <<  " | " << pen.getScreenWidth() << " LT " << pen.getLineType();
     lastPaintEntityPen.updateBy(originalPen);
     painter->setPen(pen);
-#ifdef DEBUG_RENDERING
-    setPenTime += setPenTimer.nsecsElapsed();
-#endif
 }
 
 /**
@@ -115,6 +115,10 @@ protected:
     void setPenForOverlayEntity(RS_Painter *painter, RS_Entity *e);
     void renderEntity(RS_Painter *painter, RS_Entity *e) override;
     void doSetupBeforeContainerDraw() override;
+    std::unique_ptr<LC_WidgetViewPortRenderer> createTileRenderer() override;
+    void syncTileRenderer(LC_WidgetViewPortRenderer* tileRenderer) override;
+    int getTileRenderingFlags() const override;
+    bool isLayerCachingSupported() const override {return true;}
 };
 
 #endif // LC_GRAPHICVIEWRENDERER_H
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#include "lc_layerrendercache.h"
+
+#include <algorithm>
+
+#include <QPainter>
+
+#include "rs_layer.h"
+#include "rs_layerlist.h"
+
+void LC_LayerRenderCache::clear() {
+    for (Group& group: m_groups) {
+        group.pixmap = QPixmap();
+        group.valid = false;
+    }
+}
+
+/**
+ * Unlike tiles, pixmaps of groups cover the viewport, so they are obsolete after any change of the view.
+ */
+void LC_LayerRenderCache::setViewState(const LC_DrawingTilesViewState& state, int width, int height, int offsetX, int offsetY) {
+    if (state != m_viewState || width != m_width || height != m_height || offsetX != m_offsetX || offsetY != m_offsetY) {
+        m_viewState = state;
+        m_width = width;
+        m_height = height;
+        m_offsetX = offsetX;
+        m_offsetY = offsetY;
+        clear();
+    }
+}
+
+/**
+ * Assigns layers to groups. Assignment is kept while the layer list is the same, as otherwise content of all groups
+ * should be rendered again.
+ */
+void LC_LayerRenderCache::setLayers(RS_LayerList* layerList, int maxGroupsCount) {
+    const int layersCount = static_cast<int>(layerList->count());
+    const int groupsCount = std::max(1, std::min(maxGroupsCount, layersCount));
+    bool sameLayers = groupsCount == getGroupsCount() && layersCount == static_cast<int>(m_layers.size());
+    for (int i = 0; sameLayers && i < layersCount; i++) {
+        sameLayers = layerList->at(i) == m_layers[i];
+    }
+    if (sameLayers) {
+        return;
+    }
+
+    m_groups.assign(groupsCount, Group());
+    m_layers.resize(layersCount);
+    m_layerGroups.clear();
+    for (int i = 0; i < layersCount; i++) {
+        RS_Layer* layer = layerList->at(i);
+        m_layers[i] = layer;
+        m_layerGroups[layer] = i * groupsCount / layersCount;
+    }
+}
+
+void LC_LayerRenderCache::invalidateLayer(RS_Layer* layer) {
+    auto it = m_layerGroups.find(layer);
+    if (it == m_layerGroups.end()) {
+        clear();
+        return;
+    }
+    for (int i = 0; i < getGroupsCount(); i++) {
+        Group& group = m_groups[i];
+        if (i == it->second || group.dependsOnAllLayers) {
+            group.pixmap = QPixmap();
+            group.valid = false;
+        }
+    }
+}
+
+/**
+ * Entities without layer are rendered with the first group.
+ */
+int LC_LayerRenderCache::getGroup(RS_Layer* layer) const {
+    auto it = m_layerGroups.find(layer);
+    return it == m_layerGroups.end() ? 0 : it->second;
+}
+
+/**
+ * Stores rendered content of the group. Null pixmap means that there is nothing to draw for the group.
+ */
+void LC_LayerRenderCache::setGroup(int group, QPixmap pixmap, bool dependsOnAllLayers) {
+    Group& g = m_groups[group];
+    g.pixmap = std::move(pixmap);
+    g.dependsOnAllLayers = dependsOnAllLayers;
+    g.valid = true;
+}
+
+void LC_LayerRenderCache::draw(QPainter* painter) const {
+    for (const Group& group: m_groups) {
+        if (!group.pixmap.isNull()) {
+            painter->drawPixmap(0, 0, group.pixmap);
+        }
+    }
+}
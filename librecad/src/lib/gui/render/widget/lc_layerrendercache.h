@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_LAYERRENDERCACHE_H
+#define LC_LAYERRENDERCACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <QPixmap>
+
+#include "lc_drawingtilecache.h"
+
+class QPainter;
+class RS_Layer;
+class RS_LayerList;
+
+/**
+ * Cache of the drawing layer rendered by groups of layers. Layers of the layer list are split into up to the given
+ * number of groups of adjacent layers, entities of each group are rendered into own transparent pixmap, and pixmaps
+ * are composited in the order of layers. Changing a layer (visibility, lock, print, attributes) invalidates only the
+ * group of that layer, so other groups are just composited again.
+ * Groups with inserts depend on all layers, as entities of blocks may be on any layer.
+ */
+class LC_LayerRenderCache {
+public:
+    LC_LayerRenderCache() = default;
+    void clear();
+    void setViewState(const LC_DrawingTilesViewState& state, int width, int height, int offsetX, int offsetY);
+    void setLayers(RS_LayerList* layerList, int maxGroupsCount);
+    void invalidateLayer(RS_Layer* layer);
+    int getGroupsCount() const {return static_cast<int>(m_groups.size());}
+    int getGroup(RS_Layer* layer) const;
+    bool isGroupValid(int group) const {return m_groups[group].valid;}
+    void setGroup(int group, QPixmap pixmap, bool dependsOnAllLayers);
+    void draw(QPainter* painter) const;
+private:
+    struct Group {
+        QPixmap pixmap;
+        bool dependsOnAllLayers = false;
+        bool valid = false;
+    };
+    LC_DrawingTilesViewState m_viewState;
+    int m_width = 0;
+    int m_height = 0;
+    int m_offsetX = 0;
+    int m_offsetY = 0;
+
+    std::vector<Group> m_groups;
+    std::vector<RS_Layer*> m_layers;
+    std::unordered_map<RS_Layer*, int> m_layerGroups;
+};
+
+#endif // LC_LAYERRENDERCACHE_H
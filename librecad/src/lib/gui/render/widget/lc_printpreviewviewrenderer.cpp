@@ -23,6 +23,7 @@
 #include "lc_printpreviewviewrenderer.h"
 
 #include "lc_graphicviewport.h"
+#include "lc_profiler.h"
 #include "rs_graphic.h"
 #include "rs_math.h"
 #include "rs_painter.h"
@@ -163,25 +164,13 @@ void LC_PrintPreviewViewRenderer::renderEntity(RS_Painter *painter, RS_Entity *e
     if (/*!e->isContainer() && */(e->getFlag(RS2::FlagSelected) != painter->shouldDrawSelected())) {
         return;
     }
-#ifdef DEBUG_RENDERING
-    isVisibleTimer.start();
-#endif
     // entity is not visible:
     bool visible = e->isVisible();
-#ifdef DEBUG_RENDERING
-    isVisibleTime += isVisibleTimer.nsecsElapsed();
-#endif
     if (!visible) {
         return;
     }
 
-#ifdef DEBUG_RENDERING
-    isConstructionTimer.start();
-#endif
     bool constructionEntity = e->isConstruction();
-#ifdef DEBUG_RENDERING
-    isConstructionTime += isConstructionTimer.nsecsElapsed();
-#endif
 
     if (!e->isPrint() || constructionEntity)
         return;
@@ -196,9 +185,7 @@ void LC_PrintPreviewViewRenderer::renderEntity(RS_Painter *painter, RS_Entity *e
 }
 
 void LC_PrintPreviewViewRenderer::setPenForPrintingEntity(RS_Painter *painter, RS_Entity *e) {
-#ifdef DEBUG_RENDERING
-    setPenTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionSetPen);
     // Getting pen from entity (or layer)
     RS_Pen pen = e->getPenResolved();
     RS_Pen originalPen = pen;
@@ -269,9 +256,6 @@ void LC_PrintPreviewViewRenderer::setPenForPrintingEntity(RS_Painter *painter, R
     // we store original pen as last painted, not resolved one - since original pen lead to resulting resolved and may be used by the next entity
     lastPaintEntityPen.updateBy(originalPen);
     painter->setPen(pen);
-#ifdef DEBUG_RENDERING
-    setPenTime += setPenTimer.nsecsElapsed();
-#endif
 }
 
 void LC_PrintPreviewViewRenderer::setupPainter(RS_Painter *painter)  {
@@ -287,6 +271,7 @@ void LC_PrintPreviewViewRenderer::setupPainter(RS_Painter *painter)  {
     painter->setPenCapStyle(Qt::RoundCap);
     painter->setPenJoinStyle(Qt::RoundJoin);
     painter->setMinRenderableTextHeightInPx(0);
+    painter->setLevelOfDetail(0, 0);
 
     painter->setRenderArcsInterpolate(true);
     painter->setRenderArcsInterpolationAngleFixed(true);
@@ -21,24 +21,97 @@
  ******************************************************************************/
 #include "lc_widgetviewportrenderer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QImage>
 #include <QPixmap>
+#include <QThread>
+#include <QThreadPool>
+#include <QWidget>
 
+#include "lc_arctessellationcache.h"
+#include "lc_drawingtilecache.h"
 #include "lc_graphicviewport.h"
+#include "lc_layerrendercache.h"
+#include "lc_profiler.h"
 #include "rs_entitycontainer.h"
+#include "rs_graphic.h"
 #include "rs_math.h"
 #include "rs_painter.h"
 #include "rs_settings.h"
 
+namespace {
+    /**
+     * Stops rendering of tiles before the gui thread handles any event that may run code modifying the document read
+     * by workers: input (including mouse moves, as actions highlight entities), timers, queued calls (e.g. callbacks
+     * of documents loader) and so on. Only events that repaint or track the cursor over widgets are let through,
+     * along with notifications of workers sent to the guard itself.
+     */
+    class LC_TilesFrameGuard: public QObject {
+    public:
+        explicit LC_TilesFrameGuard(std::function<void()> stopFrame)
+            :m_stopFrame{std::move(stopFrame)} {
+        }
+
+        bool eventFilter(QObject* watched, QEvent* event) override {
+            if (watched != this) {
+                switch (event->type()) {
+                    case QEvent::Paint:
+                    case QEvent::UpdateRequest:
+                    case QEvent::UpdateLater:
+                    case QEvent::Enter:
+                    case QEvent::Leave:
+                    case QEvent::HoverEnter:
+                    case QEvent::HoverLeave:
+                    case QEvent::HoverMove:
+                        break;
+                    default:
+                        m_stopFrame();
+                        break;
+                }
+            }
+            return QObject::eventFilter(watched, event);
+        }
+    private:
+        std::function<void()> m_stopFrame;
+    };
+}
+
+/**
+ * Tiles of the drawing layer rendered by workers. Everything workers need from the viewport is captured
+ * by the gui thread, so the viewport may be changed while they render.
+ */
+struct LC_WidgetViewPortRenderer::TilesFrame {
+    unsigned generation = 0;
+    LC_GraphicViewportState viewportState;
+    std::vector<QPoint> tiles;
+    std::vector<QPoint> uiOrigins;
+    std::vector<LC_Rect> clipRects;
+    std::atomic<size_t> nextTile{0};
+    std::atomic<size_t> runningJobs{0};
+    std::mutex mutex;
+    // rendered tiles not taken by the gui thread yet
+    std::vector<std::pair<QPoint, QImage>> rendered;
+};
+
 LC_WidgetViewPortRenderer::LC_WidgetViewPortRenderer(LC_GraphicViewport *viewport, QPaintDevice* paintDevice):
     LC_GraphicViewportRenderer(viewport, paintDevice)
     , pixmapLayerBackground{ std::make_unique<QPixmap>() }
     , pixmapLayerDrawing{ std::make_unique<QPixmap>() }
     , pixmapLayerOverlays{ std::make_unique<QPixmap>() }
+    , m_arcTessellationCache{ std::make_unique<LC_ArcTessellationCache>() }
     , m_pixmapLayer1{ std::make_unique<QPixmap>(1,1) }
 {
 }
 
-LC_WidgetViewPortRenderer::~LC_WidgetViewPortRenderer() = default;
+LC_WidgetViewPortRenderer::~LC_WidgetViewPortRenderer() {
+    stopTilesFrame();
+}
 
 
 void LC_WidgetViewPortRenderer::loadSettings() {
@@ -78,28 +151,60 @@ void LC_WidgetViewPortRenderer::loadSettings() {
         m_render_arcsInterpolateMaxSagitta = sagittaMax / 100.0;
 
         m_render_circlesSameAsArcs = LC_GET_BOOL("CircleRenderAsArcs", false);
+
+        // opt-in, proxies change how small entities look
+        if (LC_GET_BOOL("LevelOfDetail", false)) {
+            m_render_lodPointSize = LC_GET_INT("LevelOfDetailPointSize", 100) / 100.0;
+            m_render_lodProxySize = LC_GET_INT("LevelOfDetailProxySize", 300) / 100.0;
+        }
+        else {
+            m_render_lodPointSize = 0.;
+            m_render_lodProxySize = 0.;
+        }
+
+        m_tiledDrawingLayer = LC_GET_BOOL("TiledDrawingLayer", false);
+        m_layerCaching = LC_GET_BOOL("LayerCaches", false);
+        m_layerCachingGroups = std::max(1, LC_GET_INT("LayerCachesGroups", 16));
     } // Render group
     LC_GROUP_END();
+
+    // settings of tile renderers, already rendered tiles and arc shapes are obsolete now
+    stopTilesFrame();
+    m_tilesFrame.reset();
+    m_tileRenderers.clear();
+    m_arcTessellationCache->clear();
+    m_drawingContentChanged = true;
 }
 
-void LC_WidgetViewPortRenderer::doRender() {
+void LC_WidgetViewPortRenderer::invalidate(RS2::RedrawMethod method) {
+    redrawMethod = static_cast<RS2::RedrawMethod>(redrawMethod | method);
+    if (method & RS2::RedrawDrawing) {
+        m_drawingContentChanged = true;
+        // tiles being rendered are obsolete
+        stopTilesFrame();
+    }
+}
 
-#ifdef DEBUG_RENDERING
-    QElapsedTimer timer;
-    timer.start();
-    drawEntityCount = 0;
-    entityDrawTime = 0;
-    isVisibleTime = 0;
-    isConstructionTime  = 0;
-    setPenTime = 0;
-    painterSetPenTime = 0;
-    getPenTime = 0;
-
-
-    drawLayerBackgroundTime = 0;
-    drawLayerEntitiesTime = 0;
-    drawLayerOverlaysTime = 0;
-#endif
+/**
+ * Invalidates the drawing layer after change of the given layer. If the drawing layer is cached by layers, only
+ * groups affected by the layer are rendered again, otherwise the whole drawing is.
+ */
+void LC_WidgetViewPortRenderer::invalidateLayer(RS_Layer* layer) {
+    bool cachedByLayers = m_layerCaching && !m_tiledDrawingLayer && m_layerCache != nullptr && !m_drawingContentChanged;
+    if (cachedByLayers && layer != nullptr) {
+        m_layerCache->invalidateLayer(layer);
+        invalidate(RS2::RedrawViewport);
+    }
+    else {
+        invalidate(RS2::RedrawDrawing);
+    }
+}
+
+void LC_WidgetViewPortRenderer::doRender() {
+    bool profiling = LC_Profiler::isEnabled();
+    if (profiling) {
+        LC_PROFILER->beginFrame();
+    }
     if (antialiasing){
         if (classicRenderer) {
             paintClassicalBuffered(pd);
@@ -111,13 +216,9 @@ void LC_WidgetViewPortRenderer::doRender() {
     else{
         paintClassicalBuffered(pd);
     }
-
-#ifdef DEBUG_RENDERING
-    LC_ERR<<"Paint:"  << timer.elapsed() <<
-    " Layer 1 - Background: "  << drawLayerBackgroundTime <<" Layer 2 - Entities:"  << drawLayerEntitiesTime  <<" Layer 3 - overlays: "  << drawLayerOverlaysTime
-    << " Entity Draw: " << entityDrawTime*1e-6 <<  " isVisible: " << isVisibleTime*1e-6 <<  " isConstruction: " << isConstructionTime*1e-6
-    << " setPen: " << setPenTime*1e-6 <<  " getPen: " << getPenTime*1e-6 << " painter setPen: " << painterSetPenTime*1e-6 << " Entities: " << drawEntityCount;
-#endif
+    if (profiling) {
+        LC_PROFILER->endFrame();
+    }
 
     redrawMethod=RS2::RedrawNone;
 }
@@ -141,14 +242,13 @@ void LC_WidgetViewPortRenderer::paintSequental(QPaintDevice* pd) {
         redrawMethod=(RS2::RedrawMethod ) (redrawMethod | RS2::RedrawDrawing);
     }
 
-    if (redrawMethod & RS2::RedrawDrawing) {
+    if (redrawMethod & (RS2::RedrawDrawing | RS2::RedrawViewport)) {
         // DRaw layer 2
         *pixmapLayerDrawing = *pixmapLayerBackground;
         RS_Painter painterLayerDrawing(pixmapLayerDrawing.get());
         setupPainter(&painterLayerDrawing);
 
-        drawLayerEntities(&painterLayerDrawing);
-        drawLayerEntitiesOver(&painterLayerDrawing);
+        drawLayerDrawing(&painterLayerDrawing);
         painterLayerDrawing.end();
         redrawMethod=(RS2::RedrawMethod ) (redrawMethod | RS2::RedrawOverlay);
     }
@@ -187,13 +287,12 @@ void LC_WidgetViewPortRenderer::paintClassicalBuffered(QPaintDevice* pd) {
         drawLayerBackground(&painterBackground);
     }
 
-    if (redrawMethod & RS2::RedrawDrawing) {
+    if (redrawMethod & (RS2::RedrawDrawing | RS2::RedrawViewport)) {
         // DRaw layer 2
         m_pixmapLayer2->fill(Qt::transparent);
         RS_Painter painterLayerDrawing(m_pixmapLayer2.get());
         setupPainter(&painterLayerDrawing);
-        drawLayerEntities(&painterLayerDrawing);
-        drawLayerEntitiesOver(&painterLayerDrawing);
+        drawLayerDrawing(&painterLayerDrawing);
     }
 
     if (redrawMethod & RS2::RedrawOverlay) {
@@ -226,6 +325,9 @@ void LC_WidgetViewPortRenderer::setupPainter(RS_Painter *painter) {
     painter->setRenderArcsInterpolationAngleValue(m_render_arcsInterpolateAngleValue);
     painter->setRenderArcsInterpolationMaxSagitta(m_render_arcsInterpolateMaxSagitta);
     painter->setRenderCirclesSameAsArcs(m_render_circlesSameAsArcs);
+    painter->setLevelOfDetail(m_render_lodPointSize, m_render_lodProxySize);
+    m_arcTessellationCache->setViewFactor(m_viewportState != nullptr ? m_viewportState->factor.x : viewport->getFactor().x);
+    painter->setArcTessellationCache(m_arcTessellationCache.get());
 
     if (antialiasing) {
         painter->setRenderHint(QPainter::Antialiasing);
@@ -234,24 +336,17 @@ void LC_WidgetViewPortRenderer::setupPainter(RS_Painter *painter) {
 
 
 void LC_WidgetViewPortRenderer::drawLayerBackground(RS_Painter *painter) {
-#ifdef DEBUG_RENDERING_DETAILS
-    drawLayerBackgroundTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionBackground);
     doDrawLayerBackground(painter);
-#ifdef DEBUG_RENDERING_DETAILS
-    drawLayerBackgroundTime += drawLayerBackgroundTimer.elapsed();
-#endif
 }
 
 
 // fixme - sand - ADD additional pass with ordering of entities - in order to draw construction entities under normal ones!!!
 
 void LC_WidgetViewPortRenderer::drawLayerEntities(RS_Painter* painter) {
-#ifdef DEBUG_RENDERING_DETAILS
-    drawLayerEntitiesTimer.start();
-#endif
-
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionEntities);
     RS_EntityContainer *container = viewport->getContainer();
+    beginLinesBatching();
     painter->setDrawSelectedOnly(false);
     doSetupBeforeContainerDraw();
     justDrawEntity(painter, container);
@@ -259,10 +354,328 @@ void LC_WidgetViewPortRenderer::drawLayerEntities(RS_Painter* painter) {
     painter->setDrawSelectedOnly(true);
     doSetupBeforeContainerDraw();
     justDrawEntity(painter, container);
+    endLinesBatching(painter);
+}
+
+void LC_WidgetViewPortRenderer::drawLayerDrawing(RS_Painter* painter) {
+    bool drawn = (m_tiledDrawingLayer && drawLayerEntitiesTiled(painter))
+                 || (m_layerCaching && drawLayerEntitiesByLayers(painter));
+    if (!drawn) {
+        drawLayerEntities(painter);
+    }
+    drawLayerEntitiesOver(painter);
+}
+
+/**
+ * Draws entities of the drawing layer by groups of layers. Only groups that were invalidated since the previous
+ * frame are rendered, others are just composited from the cache. Entities are composited in the order of layers
+ * rather than in the order of the document. Selected entities are drawn over all groups and are not cached.
+ * Returns false if caching by layers is not supported, so the layer should be drawn directly.
+ */
+bool LC_WidgetViewPortRenderer::drawLayerEntitiesByLayers(RS_Painter* painter) {
+    if (graphic == nullptr || !isLayerCachingSupported()) {
+        return false;
+    }
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionEntities);
+    if (m_layerCache == nullptr) {
+        m_layerCache = std::make_unique<LC_LayerRenderCache>();
+    }
+    if (m_drawingContentChanged) {
+        m_layerCache->clear();
+        m_drawingContentChanged = false;
+    }
+    const int width = viewport->getWidth();
+    const int height = viewport->getHeight();
+    m_layerCache->setViewState(getTilesViewState(), width, height, viewport->getOffsetX(), viewport->getOffsetY());
+    m_layerCache->setLayers(graphic->getLayerList(), m_layerCachingGroups);
+
+    RS_EntityContainer *container = viewport->getContainer();
+    const int groupsCount = m_layerCache->getGroupsCount();
+    std::vector<std::vector<RS_Entity*>> groupEntities(groupsCount);
+    std::vector<bool> groupHasInserts(groupsCount, false);
+    bool hasInvalidGroups = false;
+    for (int group = 0; group < groupsCount; group++) {
+        hasInvalidGroups = hasInvalidGroups || !m_layerCache->isGroupValid(group);
+    }
+    if (hasInvalidGroups) {
+        for (RS_Entity* e: *container) {
+            if (e != nullptr && e->getId() != 0) {
+                int group = m_layerCache->getGroup(e->getLayer());
+                if (!m_layerCache->isGroupValid(group)) {
+                    groupEntities[group].push_back(e);
+                    if (e->rtti() == RS2::EntityInsert) {
+                        groupHasInserts[group] = true;
+                    }
+                }
+            }
+        }
+        for (int group = 0; group < groupsCount; group++) {
+            if (m_layerCache->isGroupValid(group)) {
+                continue;
+            }
+            QPixmap pixmap;
+            if (!groupEntities[group].empty()) {
+                pixmap = QPixmap(width, height);
+                pixmap.fill(Qt::transparent);
+                RS_Painter groupPainter(&pixmap);
+                setupPainter(&groupPainter);
+                beginLinesBatching();
+                groupPainter.setDrawSelectedOnly(false);
+                doSetupBeforeContainerDraw();
+                for (RS_Entity* e: groupEntities[group]) {
+                    groupPainter.drawEntity(e);
+                }
+                endLinesBatching(&groupPainter);
+                groupPainter.end();
+            }
+            m_layerCache->setGroup(group, std::move(pixmap), groupHasInserts[group]);
+        }
+    }
+    m_layerCache->draw(painter);
+
+    beginLinesBatching();
+    painter->setDrawSelectedOnly(true);
+    doSetupBeforeContainerDraw();
+    justDrawEntity(painter, container);
+    endLinesBatching(painter);
+    return true;
+}
 
-#ifdef DEBUG_RENDERING_DETAILS
-    drawLayerEntitiesTime += drawLayerEntitiesTimer.elapsed();
-#endif
+/**
+ * Draws entities of the drawing layer by tiles. Tiles that are not cached yet are rendered in parallel by tile
+ * renderers in worker threads, each with own painter. The paint event doesn't wait for them: tiles rendered so far
+ * are composited, and workers request another paint event as they finish tiles.
+ * Workers read the document, so the frame is stopped (and workers are joined) before the gui thread handles events
+ * that may modify it, and on any change of the drawing. Tiles of stopped frames are dropped, missing tiles are
+ * rendered by the next frame.
+ * Returns false if tiled rendering is not supported, so the layer should be drawn directly.
+ */
+bool LC_WidgetViewPortRenderer::drawLayerEntitiesTiled(RS_Painter* painter) {
+    if (m_tileCache == nullptr) {
+        m_tileCache = std::make_unique<LC_DrawingTileCache>();
+    }
+    bool tilesObsolete = m_tileCache->setViewState(getTilesViewState());
+    if (m_drawingContentChanged || tilesObsolete) {
+        stopTilesFrame();
+        m_tilesFrame.reset();
+        m_tileCache->clear();
+        m_drawingContentChanged = false;
+    }
+    m_tileCache->setViewport(viewport->getWidth(), viewport->getHeight(), viewport->getOffsetX(), viewport->getOffsetY());
+    takeRenderedTiles();
+
+    std::vector<QPoint> missingTiles = m_tileCache->getMissingTiles();
+    if (!missingTiles.empty() && !isTilesFrameRendering(missingTiles)) {
+        // tiles exposed by panning, the frame is started again with all missing tiles
+        stopTilesFrame();
+        takeRenderedTiles();
+        missingTiles = m_tileCache->getMissingTiles();
+        if (!missingTiles.empty() && !startTilesFrame(missingTiles)) {
+            return false;
+        }
+    }
+    m_tileCache->draw(painter);
+    return true;
+}
+
+/**
+ * Starts rendering of given tiles in worker threads. Without a widget to repaint, tiles are waited for.
+ */
+bool LC_WidgetViewPortRenderer::startTilesFrame(const std::vector<QPoint>& tiles) {
+    size_t renderersCount = std::min(static_cast<size_t>(std::max(QThread::idealThreadCount(), 1)), tiles.size());
+    while (m_tileRenderers.size() < renderersCount) {
+        std::unique_ptr<LC_WidgetViewPortRenderer> tileRenderer = createTileRenderer();
+        if (tileRenderer == nullptr) {
+            return false;
+        }
+        m_tileRenderers.push_back(std::move(tileRenderer));
+    }
+    for (size_t i = 0; i < renderersCount; i++) {
+        syncTileRenderer(m_tileRenderers[i].get());
+    }
+    // recompute invalidated borders here, so workers only read them
+    viewport->getContainer()->validateBordersDeep();
+
+    const int tileSize = LC_DrawingTileCache::TILE_SIZE;
+    // entities near the tile borders are drawn too, so wide pens and point markers are not cut on tiles borders
+    const int margin = 32;
+    auto frame = std::make_shared<TilesFrame>();
+    frame->generation = m_tilesGeneration.load();
+    frame->viewportState = viewport->getState();
+    frame->tiles = tiles;
+    for (const QPoint& tile: tiles) {
+        QPoint uiOrigin = m_tileCache->getTileGuiOrigin(tile);
+        frame->uiOrigins.push_back(uiOrigin);
+        frame->clipRects.push_back(prepareBoundingClipRect(uiOrigin.x() - margin, uiOrigin.y() - margin,
+                                                           uiOrigin.x() + tileSize + margin, uiOrigin.y() + tileSize + margin));
+    }
+    frame->runningJobs = renderersCount;
+
+    auto* widget = dynamic_cast<QWidget*>(pd);
+    QCoreApplication* application = QCoreApplication::instance();
+    bool waitForTiles = widget == nullptr || application == nullptr;
+    if (!waitForTiles) {
+        if (m_tilesFrameGuard == nullptr) {
+            m_tilesFrameGuard = std::make_unique<LC_TilesFrameGuard>([this]() {
+                if (m_tilesFrame != nullptr) {
+                    stopTilesFrame();
+                    // missing tiles are rendered again after the event is handled
+                    onTilesRendered();
+                }
+            });
+        }
+        application->installEventFilter(m_tilesFrameGuard.get());
+    }
+    if (m_tilesThreadPool == nullptr) {
+        m_tilesThreadPool = std::make_unique<QThreadPool>();
+    }
+    QObject* notifier = waitForTiles ? nullptr : m_tilesFrameGuard.get();
+    for (size_t i = 0; i < renderersCount; i++) {
+        LC_WidgetViewPortRenderer* tileRenderer = m_tileRenderers[i].get();
+        m_tilesThreadPool->start([this, frame, tileRenderer, notifier]() {
+            tileRenderer->m_viewportState = &frame->viewportState;
+            tileRenderer->m_tilesGenerationCounter = &m_tilesGeneration;
+            tileRenderer->m_tileFrameGeneration = frame->generation;
+            for (size_t index = frame->nextTile++; index < frame->tiles.size(); index = frame->nextTile++) {
+                QImage image = tileRenderer->renderTile(frame->uiOrigins[index], frame->clipRects[index]);
+                if (tileRenderer->isTileFrameOutdated()) {
+                    // the tile may be partially drawn
+                    break;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(frame->mutex);
+                    frame->rendered.emplace_back(frame->tiles[index], std::move(image));
+                }
+                if (notifier != nullptr) {
+                    QMetaObject::invokeMethod(notifier, [this]() {onTilesRendered();}, Qt::QueuedConnection);
+                }
+            }
+            tileRenderer->m_viewportState = nullptr;
+            tileRenderer->m_tilesGenerationCounter = nullptr;
+            frame->runningJobs--;
+        });
+    }
+    m_tilesFrame = std::move(frame);
+    if (waitForTiles) {
+        m_tilesThreadPool->waitForDone();
+        takeRenderedTiles();
+    }
+    return true;
+}
+
+/**
+ * Returns true if all given tiles are being rendered by the current frame.
+ */
+bool LC_WidgetViewPortRenderer::isTilesFrameRendering(const std::vector<QPoint>& tiles) const {
+    if (m_tilesFrame == nullptr || m_tilesFrame->runningJobs.load() == 0) {
+        return false;
+    }
+    const std::vector<QPoint>& frameTiles = m_tilesFrame->tiles;
+    return std::all_of(tiles.begin(), tiles.end(), [&frameTiles](const QPoint& tile) {
+        return std::find(frameTiles.begin(), frameTiles.end(), tile) != frameTiles.end();
+    });
+}
+
+/**
+ * Makes workers drop tiles of the current frame and waits for them. Tiles rendered before are still taken.
+ */
+void LC_WidgetViewPortRenderer::stopTilesFrame() {
+    if (m_tilesFrame == nullptr) {
+        return;
+    }
+    m_tilesGeneration++;
+    m_tilesThreadPool->waitForDone();
+    if (m_tilesFrameGuard != nullptr && QCoreApplication::instance() != nullptr) {
+        QCoreApplication::instance()->removeEventFilter(m_tilesFrameGuard.get());
+    }
+}
+
+/**
+ * Moves tiles rendered by workers into the cache. The frame is released once all workers are done.
+ */
+void LC_WidgetViewPortRenderer::takeRenderedTiles() {
+    if (m_tilesFrame == nullptr) {
+        return;
+    }
+    // checked before taking tiles, so tiles added by the last workers are taken too
+    bool finished = m_tilesFrame->runningJobs.load() == 0;
+    std::vector<std::pair<QPoint, QImage>> rendered;
+    {
+        std::lock_guard<std::mutex> lock(m_tilesFrame->mutex);
+        rendered.swap(m_tilesFrame->rendered);
+    }
+    for (auto& [tile, image]: rendered) {
+        m_tileCache->setTile(tile, std::move(image));
+    }
+    if (finished) {
+        stopTilesFrame();
+        m_tilesFrame.reset();
+    }
+}
+
+/**
+ * Called on the gui thread as workers finish tiles, the drawing layer is composited again by the next paint event.
+ */
+void LC_WidgetViewPortRenderer::onTilesRendered() {
+    auto* widget = dynamic_cast<QWidget*>(pd);
+    if (widget != nullptr) {
+        invalidate(RS2::RedrawViewport);
+        widget->update();
+    }
+}
+
+/**
+ * Renders entities that are within the tile with given gui origin. Called in the worker thread for the tile renderer.
+ */
+QImage LC_WidgetViewPortRenderer::renderTile(const QPoint& uiOrigin, const LC_Rect& clipRect) {
+    const int tileSize = LC_DrawingTileCache::TILE_SIZE;
+    QImage tile(tileSize, tileSize, QImage::Format_ARGB32_Premultiplied);
+    tile.fill(Qt::transparent);
+
+    renderBoundingClipRect = clipRect;
+    RS_Painter painter(&tile);
+    painter.setViewPortTileOrigin(uiOrigin.x(), uiOrigin.y());
+    setupPainter(&painter);
+    drawLayerEntities(&painter);
+    painter.end();
+    return tile;
+}
+
+/**
+ * Passes to the tile renderer the state that may be changed without reloading of settings.
+ */
+void LC_WidgetViewPortRenderer::syncTileRenderer(LC_WidgetViewPortRenderer* tileRenderer) {
+    tileRenderer->graphic = graphic;
+    if (graphic != nullptr) {
+        tileRenderer->updateGraphicRelatedSettings(graphic);
+    }
+    tileRenderer->m_colorBackground = m_colorBackground;
+    tileRenderer->m_colorForeground = m_colorForeground;
+    tileRenderer->m_scaleLineWidth = m_scaleLineWidth;
+    tileRenderer->antialiasing = antialiasing;
+}
+
+/**
+ * Flags of rendering mode that affect content of tiles
+ */
+int LC_WidgetViewPortRenderer::getTileRenderingFlags() const {
+    return (m_scaleLineWidth ? 1 : 0) | (antialiasing ? 2 : 0);
+}
+
+LC_DrawingTilesViewState LC_WidgetViewPortRenderer::getTilesViewState() const {
+    LC_DrawingTilesViewState result;
+    const RS_Vector factor = viewport->getFactor();
+    result.factorX = factor.x;
+    result.factorY = factor.y;
+    result.hasUcs = viewport->hasUCS();
+    if (result.hasUcs) {
+        const RS_Vector &ucsOrigin = viewport->getUcsOrigin();
+        result.ucsOriginX = ucsOrigin.x;
+        result.ucsOriginY = ucsOrigin.y;
+        result.xAxisAngle = viewport->getXAxisAngle();
+    }
+    result.renderingFlags = getTileRenderingFlags();
+    return result;
 }
 
 void LC_WidgetViewPortRenderer::doSetupBeforeContainerDraw() {
@@ -272,11 +685,6 @@ void LC_WidgetViewPortRenderer::doSetupBeforeContainerDraw() {
 
 
 void LC_WidgetViewPortRenderer::drawLayerOverlays(RS_Painter *painter) {
-#ifdef DEBUG_RENDERING_DETAILS
-    drawLayerOverlaysTimer.start();
-#endif
+    LC_Profiler::Scope profilerScope(LC_Profiler::SectionOverlays);
     doDrawLayerOverlays(painter);
-#ifdef DEBUG_RENDERING_DETAILS
-    drawLayerOverlaysTime +=  drawLayerOverlaysTimer.elapsed();
-#endif
 }
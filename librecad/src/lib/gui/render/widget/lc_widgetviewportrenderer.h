@@ -23,9 +23,23 @@
 #ifndef LC_WIDGETVIEWPORTRENDERER_H
 #define LC_WIDGETVIEWPORTRENDERER_H
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "lc_graphicviewportrenderer.h"
 
+class LC_ArcTessellationCache;
+class LC_DrawingTileCache;
+struct LC_DrawingTilesViewState;
+class LC_LayerRenderCache;
+class RS_Layer;
+class QImage;
+class QObject;
 class QPixmap;
+class QPoint;
+class QThreadPool;
+class QWidget;
 
 class LC_WidgetViewPortRenderer:public LC_GraphicViewportRenderer
 {
@@ -35,9 +49,21 @@ public:
     void loadSettings() override;
     void setupPainter(RS_Painter* painter) override;
     void setAntialiasing(bool state) {antialiasing = state;}
-    void invalidate(RS2::RedrawMethod method) {redrawMethod = static_cast<RS2::RedrawMethod>(redrawMethod | method);}
+    void invalidate(RS2::RedrawMethod method);
+    void invalidateLayer(RS_Layer* layer);
 protected:
     void doRender() override;
+    /**
+     * Creates the renderer that draws tiles of the drawing layer in worker threads.
+     * Returns nullptr if tiled rendering is not supported by the renderer.
+     */
+    virtual std::unique_ptr<LC_WidgetViewPortRenderer> createTileRenderer() {return nullptr;}
+    virtual void syncTileRenderer(LC_WidgetViewPortRenderer* tileRenderer);
+    virtual int getTileRenderingFlags() const;
+    /**
+     * Returns true if the drawing layer may be rendered by groups of layers that are cached separately.
+     */
+    virtual bool isLayerCachingSupported() const {return false;}
 
     virtual void doSetupBeforeContainerDraw();
     void paintClassicalBuffered(QPaintDevice* pd);
@@ -45,6 +71,17 @@ protected:
 
     void drawLayerBackground(RS_Painter *painter);
     void drawLayerEntities(RS_Painter* painter);
+    void drawLayerDrawing(RS_Painter* painter);
+    bool drawLayerEntitiesTiled(RS_Painter* painter);
+    bool drawLayerEntitiesByLayers(RS_Painter* painter);
+    QImage renderTile(const QPoint& uiOrigin, const LC_Rect& clipRect);
+    LC_DrawingTilesViewState getTilesViewState() const;
+    /**
+     * Returns true if this renderer draws a tile of the frame that was stopped since, so the tile won't be shown.
+     */
+    bool isTileFrameOutdated() const {
+        return m_tilesGenerationCounter != nullptr && m_tilesGenerationCounter->load(std::memory_order_relaxed) != m_tileFrameGeneration;
+    }
     void drawLayerOverlays(RS_Painter *painter);
 
     virtual void drawLayerEntitiesOver([[maybe_unused]]RS_Painter* painter){}
@@ -54,16 +91,15 @@ protected:
         return m_render_minRenderableTextHeightInPx;
     }
 
-#ifdef DEBUG_RENDERING
-    QElapsedTimer drawLayerBackgroundTimer;
-    QElapsedTimer drawLayerEntitiesTimer;
-    QElapsedTimer drawLayerOverlaysTimer;
-    long drawLayerBackgroundTime = 0;
-    long drawLayerEntitiesTime = 0;
-    long drawLayerOverlaysTime = 0;
-#endif
 
 private:
+    struct TilesFrame;
+    bool startTilesFrame(const std::vector<QPoint>& tiles);
+    bool isTilesFrameRendering(const std::vector<QPoint>& tiles) const;
+    void stopTilesFrame();
+    void takeRenderedTiles();
+    void onTilesRendered();
+
     bool antialiasing = false;
     bool classicRenderer = true;
 
@@ -73,6 +109,28 @@ private:
 
     RS2::RedrawMethod redrawMethod = RS2::RedrawAll;
 
+    // drawing layer rendered by tiles in worker threads
+    bool m_tiledDrawingLayer = false;
+    bool m_drawingContentChanged = true;
+    std::unique_ptr<LC_DrawingTileCache> m_tileCache;
+    std::vector<std::unique_ptr<LC_WidgetViewPortRenderer>> m_tileRenderers;
+    std::unique_ptr<QThreadPool> m_tilesThreadPool;
+    // tiles being rendered by workers, finished tiles are composited by following paint events
+    std::shared_ptr<TilesFrame> m_tilesFrame;
+    // incremented when the frame is stopped, so workers drop its tiles
+    std::atomic<unsigned> m_tilesGeneration{0};
+    // stops the frame before input events that may modify the document, receives notifications of workers
+    std::unique_ptr<QObject> m_tilesFrameGuard;
+    // set for tile renderers while they render a frame
+    const std::atomic<unsigned>* m_tilesGenerationCounter = nullptr;
+    unsigned m_tileFrameGeneration = 0;
+    // drawing layer rendered by groups of layers, so changes of one layer don't require rendering of others
+    bool m_layerCaching = false;
+    int m_layerCachingGroups = 16;
+    std::unique_ptr<LC_LayerRenderCache> m_layerCache;
+    // arc shapes reused between frames, each tile renderer has own cache
+    std::unique_ptr<LC_ArcTessellationCache> m_arcTessellationCache;
+
     int m_render_minRenderableTextHeightInPx = 4;
     double m_render_minCircleDrawingRadius = 2.0;
     double m_render_minArcDrawingRadius = 0.5;
@@ -85,6 +143,9 @@ private:
     double m_render_arcsInterpolateAngleValue = M_PI / 36;
     double m_render_arcsInterpolateMaxSagitta = 0.9;
     bool m_render_circlesSameAsArcs = false;
+    // entities smaller on the screen are drawn as point or box proxies, zero disables the proxy
+    double m_render_lodPointSize = 0.;
+    double m_render_lodProxySize = 0.;
 
     // Used for buffering different paint layers
     std::unique_ptr<QPixmap> m_pixmapLayer1;  // Used for grids and absolute 0
@@ -258,7 +258,7 @@ void RS_GraphicView::onViewportChanged() {
     adjustZoomControls();
     QString info = m_viewport->getGrid()->getInfo();
     updateGridStatusWidget(info);
-    redraw();
+    redraw(static_cast<RS2::RedrawMethod>(RS2::RedrawGrid | RS2::RedrawOverlay | RS2::RedrawViewport));
 }
 
 void RS_GraphicView::onViewportRedrawNeeded() {
@@ -269,7 +269,7 @@ void RS_GraphicView::onUCSChanged(LC_UCS* ucs) {
     emit ucsChanged(ucs);
     QString info = m_viewport->getGrid()->getInfo();
     updateGridStatusWidget(info);
-    redraw();
+    redraw(static_cast<RS2::RedrawMethod>(RS2::RedrawGrid | RS2::RedrawOverlay | RS2::RedrawViewport));
 }
 
 void RS_GraphicView::notifyNoActiveAction(){
@@ -25,6 +25,9 @@
 **********************************************************************/
 
 #include <cmath>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include <boost/numeric/ublas/lu.hpp>
 #include <boost/math/special_functions/ellint_2.hpp>
@@ -61,6 +64,131 @@ const QRegularExpression unitreg(
                 R"((?:(?P<numer>\d+)\/(?P<denom>\d+))?)"                // rational inches
         R"((?:inches|inch|in|"))?$)))"
 	);
+
+mu::string_type toMuString(const QString& str) {
+#ifdef _UNICODE
+    return str.toStdWString();
+#else
+    return str.toStdString();
+#endif
+}
+
+/**
+ * Expressions compiled by muparser, shared by all threads. Cached expressions are neither derationalized nor
+ * parsed again, so repeated evaluation of the same text costs the bytecode execution only.
+ * Expressions entered by the user are derationalized and may use "pi", expressions with variables
+ * (e.g. functional dimension texts) are compiled as they are.
+ */
+class ExpressionCache {
+public:
+    struct Expression {
+        // mu::Parser evaluation is not reentrant
+        std::mutex mutex;
+        // nullptr for an invalid expression, so it's not parsed again either
+        std::unique_ptr<mu::Parser> parser;
+        // values of variables, bound to the parser by pointers
+        std::vector<double> values;
+    };
+
+    /**
+     * @param variables names of variables, values are set to Expression::values in the same order
+     * @param userInput whether the expression is derationalized and "pi" is defined
+     */
+    std::shared_ptr<Expression> get(const QString& expr, const std::vector<QString>& variables, bool userInput) {
+        QString key = (userInput ? QChar('u') : QChar('v')) + expr.trimmed();
+        for (const QString& name: variables) {
+            key += QChar(0) + name;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_expressions.find(key);
+            if (it != m_expressions.end()) {
+                return it->second;
+            }
+        }
+        std::shared_ptr<Expression> compiled = compile(expr.trimmed(), variables, userInput);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_expressions.size() >= MAX_EXPRESSIONS) {
+            // expressions in use are kept by their callers
+            m_expressions.clear();
+        }
+        return m_expressions.emplace(key, compiled).first->second;
+    }
+
+    static std::shared_ptr<Expression> compile(const QString& expr, const std::vector<QString>& variables, bool userInput) {
+        auto compiled = std::make_shared<Expression>();
+        compiled->values.resize(variables.size(), 0.);
+        try {
+            auto parser = std::make_unique<mu::Parser>();
+            if (userInput) {
+                parser->DefineConst(_T("pi"), M_PI);
+            }
+            for (size_t i = 0; i < variables.size(); i++) {
+                parser->DefineVar(toMuString(variables[i]), &compiled->values[i]);
+            }
+            parser->SetExpr(toMuString(userInput ? RS_Math::derationalize(expr) : expr));
+            // the first evaluation parses the expression into bytecode, so syntax errors are detected here
+            parser->Eval();
+            compiled->parser = std::move(parser);
+        }
+        catch (mu::Parser::exception_type &e) {
+            mu::console() << e.GetMsg() << std::endl;
+        }
+        catch (...) {
+            LC_ERR<<"MuParser error";
+        }
+        return compiled;
+    }
+
+private:
+    static constexpr size_t MAX_EXPRESSIONS = 1024;
+    std::mutex m_mutex;
+    std::unordered_map<QString, std::shared_ptr<Expression>> m_expressions;
+};
+
+ExpressionCache& expressionCache() {
+    static ExpressionCache cache;
+    return cache;
+}
+
+double evalCached(const QString& expr, const std::vector<std::pair<QString, double>>& variables, bool userInput, bool* ok) {
+    bool okTmp = false;
+    if(ok == nullptr)
+        ok=&okTmp;
+    *ok = false;
+    double ret = 0.;
+    if (expr.isEmpty()) {
+        return ret;
+    }
+
+    std::vector<QString> names;
+    names.reserve(variables.size());
+    for (const auto& [name, value]: variables) {
+        names.push_back(name);
+    }
+    std::shared_ptr<ExpressionCache::Expression> compiled = expressionCache().get(expr, names, userInput);
+    if (compiled->parser == nullptr) {
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(compiled->mutex);
+    for (size_t i = 0; i < variables.size(); i++) {
+        compiled->values[i] = variables[i].second;
+    }
+    try{
+        ret=compiled->parser->Eval();
+        *ok=true;
+    }
+    catch (mu::Parser::exception_type &e)
+    {
+        mu::console() << e.GetMsg() << std::endl;
+    }
+    catch (...)
+    {
+        LC_ERR<<"MuParser error";
+    }
+    return ret;
+}
 }
 
 /**
@@ -341,41 +469,60 @@ QString RS_Math::derationalize(const QString& expr) {
  * If an error occurred, ok will be set to false (if ok isn't NULL).
  */
 double RS_Math::eval(const QString& expr, bool* ok) {
-    bool okTmp = false;
-    if(ok == nullptr)
-        ok=&okTmp;
-    double ret = 0.;
+    return evalCached(expr, {}, true, ok);
+}
+
+/**
+ * Evaluates a mathematical expression with variables, given by names and values. Unlike user input,
+ * the expression is not derationalized and "pi" is not defined.
+ * If an error occurred, ok will be set to false (if ok isn't NULL).
+ */
+double RS_Math::eval(const QString& expr, const std::vector<std::pair<QString, double>>& variables, bool* ok) {
+    return evalCached(expr, variables, false, ok);
+}
+
+/**
+ * Evaluates a mathematical expression entered by the user for each of values of the variable.
+ * The expression is looked up and locked once for all values. If another thread is evaluating
+ * the same expression, a private copy is compiled instead of waiting for it.
+ * @return false, if the expression is invalid. Otherwise results are in the order of values.
+ */
+bool RS_Math::evalBatch(const QString& expr, const QString& variable, const std::vector<double>& values,
+                        std::vector<double>& results) {
+    results.clear();
     if (expr.isEmpty()) {
-        *ok = false;
-        return ret;
+        return false;
+    }
+    std::shared_ptr<ExpressionCache::Expression> compiled = expressionCache().get(expr, {variable}, true);
+    if (compiled->parser == nullptr) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(compiled->mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        compiled = ExpressionCache::compile(expr.trimmed(), {variable}, true);
+        lock = std::unique_lock<std::mutex>(compiled->mutex);
     }
 
-    QString derationalized = derationalize(expr);
-    //expr = normalizedUnitsExpression(expr);
-
+    results.reserve(values.size());
     try{
-        mu::Parser p;
-#ifdef _UNICODE
-        p.DefineConst(L"pi",M_PI);
-        p.SetExpr(derationalized.toStdWString());
-#else
-        p.DefineConst("pi",M_PI);
-        p.SetExpr(derationalized.toStdString());
-#endif
-        ret=p.Eval();
-        *ok=true;
+        for (double value: values) {
+            compiled->values[0] = value;
+            results.push_back(compiled->parser->Eval());
+        }
     }
     catch (mu::Parser::exception_type &e)
     {
         mu::console() << e.GetMsg() << std::endl;
-        *ok=false;
+        results.clear();
+        return false;
     }
     catch (...)
     {
         LC_ERR<<"MuParser error";
+        results.clear();
+        return false;
     }
-
-    return ret;
+    return true;
 }
 
 
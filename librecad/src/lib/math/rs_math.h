@@ -28,6 +28,7 @@
 #define RS_MATH_H
 
 #include <cmath>
+#include <utility>
 #include <vector>
 
 class QString;
@@ -98,6 +99,8 @@ QString derationalize(const QString &expr);
 //! \{ \brief evaluate a math string
 double eval(const QString &expr, double def = 0.0);
 double eval(const QString &expr, bool *ok);
+double eval(const QString &expr, const std::vector<std::pair<QString, double>> &variables, bool *ok);
+bool evalBatch(const QString &expr, const QString &variable, const std::vector<double> &values, std::vector<double> &results);
 //! \}
 
 std::vector<double> quadraticSolver(const std::vector<double> &ce);
@@ -25,7 +25,12 @@
 **********************************************************************/
 #include "rs_modification.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include <QSet>
+#include <QThread>
+#include <QThreadPool>
 
 #include "lc_graphicviewport.h"
 #include "lc_linemath.h"
@@ -57,6 +62,10 @@
 class LC_SplinePoints;
 
 namespace {
+    // minimal number of clones that are created by worker threads, and number of entities processed by worker at once
+    constexpr size_t PARALLEL_CLONES_MIN = 4096;
+    constexpr size_t PARALLEL_CHUNK_SIZE = 256;
+
 // fixme - hm, is it actually needed to mix the logic of modification and ui/undo?
 /**
  * @brief getPasteScale - find scaling factor for pasting
@@ -432,10 +441,13 @@ void RS_Modification::copy(const RS_Vector& ref, const bool cut) {
             refPoint =  bound.getCenter();
         }
 
+        // layers and blocks shared by many entities are transferred only once
+        CopyState state;
         for (auto e: selected) {
-            copyEntity(e, refPoint, cut);
+            copyEntity(e, refPoint, cut, state);
         }
         selected.clear();
+        viewport->notifyChanged();
         RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copy: OK");
     }
     else{
@@ -443,12 +455,9 @@ void RS_Modification::copy(const RS_Vector& ref, const bool cut) {
     }
 }
 
- void RS_Modification::collectSelectedEntities(std::vector<RS_Entity *> &selected) const{
-    for (auto e: *container) {
-        if (e != nullptr  && e->isSelected()) {
-            selected.push_back(e);
-        }
-    }
+void RS_Modification::collectSelectedEntities(std::vector<RS_Entity *> &selected) const{
+    // served by the selection set of documents, no scan of the container
+    container->collectSelected(selected, false);
 }
 
 RS_BoundData RS_Modification::getBoundingRect(std::vector<RS_Entity *> &selected)  {
@@ -477,8 +486,9 @@ RS_BoundData RS_Modification::getBoundingRect(std::vector<RS_Entity *> &selected
  * @param e The entity.
  * @param ref Reference point. The entities will be moved by -ref.
  * @param cut true: cut instead of copying, false: copy
+ * @param state Layers and blocks already copied by the current copy().
  */
-void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool cut) {
+void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool cut, CopyState& state) {
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity");
 
@@ -509,14 +519,13 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
     }
 
     RS_CLIPBOARD->addEntity(c);
-    copyLayers(e);
-    copyBlocks(e);
+    RS_Layer* clipboardLayer = copyLayers(e, state);
+    copyBlocks(e, state);
 
     // set layer to the layer clone:
-    auto originalLayer = e->getLayer();
     // layer could be null if copy is performed in font file, where block is open. LibreCAD#2110
-    if (originalLayer != nullptr) {
-        c->setLayer(e->getLayer()->getName());
+    if (clipboardLayer != nullptr) {
+        c->setLayer(clipboardLayer);
     }
 
 
@@ -533,7 +542,6 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
         e->setSelected(false);
     }
 
-    viewport->notifyChanged();
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: OK");
 }
 
@@ -541,25 +549,33 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
 
 /**
  * Copies all layers of the given entity to the clipboard.
+ *
+ * @return the clipboard layer of the entity.
  */
-void RS_Modification::copyLayers(RS_Entity* e) {
+RS_Layer* RS_Modification::copyLayers(RS_Entity* e, CopyState& state) {
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers");
 
 	if (!e) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyLayers: no entity is selected");
-        return;
+        return nullptr;
     }
 
     // add layer(s) of the entity insert can also be into any layer
     RS_Layer* l = e->getLayer();
     if (!l) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyLayers: no valid layer found");
-        return;
+        return nullptr;
     }
 
-    if (!RS_CLIPBOARD->hasLayer(l->getName())) {
-        RS_CLIPBOARD->addLayer(l->clone());
+    RS_Layer* clipboardLayer = state.layers.value(l, nullptr);
+    if (clipboardLayer == nullptr) {
+        clipboardLayer = RS_CLIPBOARD->getGraphic()->findLayer(l->getName());
+        if (clipboardLayer == nullptr) {
+            clipboardLayer = l->clone();
+            RS_CLIPBOARD->addLayer(clipboardLayer);
+        }
+        state.layers.insert(l, clipboardLayer);
     }
 
     // special handling of inserts:
@@ -569,16 +585,21 @@ void RS_Modification::copyLayers(RS_Entity* e) {
         RS_Block* b = ((RS_Insert*)e)->getBlockForInsert();
         if (!b) {
             RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyLayers: could not find block for insert entity");
-            return;
+            return clipboardLayer;
         }
-        for(auto e2: *b) {
-            copyLayers(e2);
+        // every further insert of that block has the same layers
+        if (!state.layersOfBlocks.contains(b)) {
+            state.layersOfBlocks.insert(b);
+            for(auto e2: *b) {
+                copyLayers(e2, state);
+            }
         }
     } else {
         RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: skip noninsert entity");
     }
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: OK");
+    return clipboardLayer;
 }
 
 
@@ -586,7 +607,7 @@ void RS_Modification::copyLayers(RS_Entity* e) {
 /**
  * Copies all blocks of the given entity to the clipboard.
  */
-void RS_Modification::copyBlocks(RS_Entity* e) {
+void RS_Modification::copyBlocks(RS_Entity* e, CopyState& state) {
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks");
 
@@ -607,6 +628,11 @@ void RS_Modification::copyBlocks(RS_Entity* e) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyBlocks: could not find block for insert entity");
         return;
     }
+    // the block and its sub-blocks are already in the clipboard
+    if (state.blocks.contains(b)) {
+        return;
+    }
+    state.blocks.insert(b);
     // add block of an insert
     QString bn = b->getName();
     if (!RS_CLIPBOARD->hasBlock(bn)) {
@@ -618,7 +644,7 @@ void RS_Modification::copyBlocks(RS_Entity* e) {
         //call copyBlocks only if entity are insert
         if (e2->rtti()==RS2::EntityInsert) {
             RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: process insert-into-insert blocks for %s", getIdFlagString(e).c_str());
-            copyBlocks(e2);
+            copyBlocks(e2, state);
         }
     }
 
@@ -659,8 +685,10 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     // remember active layer before inserting absent layers
     RS_Layer *layer = graphic->getActiveLayer();
 
-    // insert absent layers from source to graphic
-    if (!pasteLayers(source)) {
+    // insert absent layers from source to graphic, the layers of pasted
+    // entities are then looked up in layersDict
+    LayersDict layersDict;
+    if (!pasteLayers(source, layersDict)) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to copy due to absence of needed layers");
         return;
     }
@@ -675,7 +703,11 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     // hash for renaming duplicated blocks
     QHash<QString, QString> blocksDict;
 
-    // fixme - perf - is it really necessary to do something based on blocks for ordinary copy-paste?
+    if (!data.asInsert) {
+        pasteEntities(data, vfactor, *source, layersDict, blocksDict);
+        return;
+    }
+
     // create block to paste entities as a whole
     QString name_old = (data.blockName != nullptr) ? data.blockName : "paste-block";
     QString name_new = (graphic->findBlock(name_old) != nullptr) ? graphic->getBlockList()->newName(name_old) : name_old;
@@ -706,7 +738,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
 
         // paste subcontainers
         if (e->rtti() == RS2::EntityInsert) {
-            if (!pasteContainer(e, b, blocksDict, RS_Vector(0.0, 0.0))) {
+            if (!pasteContainer(e, b, blocksDict, layersDict, RS_Vector(0.0, 0.0))) {
                 RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to subcontainer paste error");
                 return;
             }
@@ -714,7 +746,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
             e->setSelected(false);
         } else {
             // paste individual entities including Polylines, etc.
-            if (!pasteEntity(e, b)) {
+            if (!pasteEntity(e, b, layersDict)) {
                 RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to entity paste error");
                 return;
             }
@@ -727,31 +759,96 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     i->update();
     i->setSelected(false);
 
-    // unblock all entities if not pasting as a new block by demand
     LC_UndoSection undo(document,viewport, handleUndo);
-    if (!data.asInsert) {
-        // no inserts should be selected except from paste block and insert
-        container->setSelected(false);
-        i->setSelected(true);
-        explode(false, true);
-        document->removeEntity(i);
-        b->clear();
-        // if this call a destructor for the block?
-        graphic->removeBlock(b);
-    } else {
-        undo.addUndoable(i);
-    }
+    undo.addUndoable(i);
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: OK");
 }
 
+/**
+ * Pastes the entities of the source as individual entities. Every source
+ * entity is cloned once, straight into the container, and transformed
+ * there, the way the insert of a paste block followed by an explode
+ * would place it.
+ */
+void RS_Modification::pasteEntities(const RS_PasteData& data, const RS_Vector& factor, RS_Graphic& source,
+                                    LayersDict& layersDict, QHash<QString, QString>& blocksDict) {
+
+    RS_Layer* activeLayer = graphic->getActiveLayer();
+    RS_Pen activePen = document->getActivePen();
+    // attributes "by block" are taken from the active pen, as an insert would do
+    auto resolvePen = [&activePen](RS_Pen pen) {
+        if (pen.getColor() == RS_Color(RS2::FlagByBlock)) {
+            pen.setColor(activePen.getColor());
+        }
+        if (pen.getWidth() == RS2::WidthByBlock) {
+            pen.setWidth(activePen.getWidth());
+        }
+        if (pen.getLineType() == RS2::LineByBlock) {
+            pen.setLineType(activePen.getLineType());
+        }
+        return pen;
+    };
+
+    // the selection of the document is cleared, and pasted entities are not selected either
+    std::vector<RS_Entity*> selected;
+    container->collectSelected(selected, false);
+    for (RS_Entity* e: selected) {
+        e->setSelected(false);
+    }
+
+    // borders are extended by pasted entities once they are placed, not at their clipboard position,
+    // so the container is not recalculated as a whole
+    bool autoUpdateBorders = container->getAutoUpdateBorders();
+    container->setAutoUpdateBorders(false);
+
+    LC_UndoSection undo(document, viewport);
+    for (auto e: source) {
+        if (!e) {
+            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::paste: nullptr entity in source");
+            continue;
+        }
+
+        RS_Entity* pasted = (e->rtti() == RS2::EntityInsert)
+                            ? pasteContainer(e, container, blocksDict, layersDict, RS_Vector(0.0, 0.0))
+                            : pasteEntity(e, container, layersDict);
+        if (pasted == nullptr) {
+            RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste entity");
+            continue;
+        }
+        e->setSelected(false);
+
+        pasted->setUpdateEnabled(false);
+        // entities on layer 0 go to the layer pasted in
+        RS_Layer* l = pasted->getLayer();
+        if (l != nullptr && l->getName() == "0") {
+            pasted->setLayer(activeLayer);
+        }
+        pasted->move(data.insertionPoint);
+        pasted->scale(data.insertionPoint, factor);
+        pasted->rotate(data.insertionPoint, data.angle);
+        pasted->setPen(resolvePen(pasted->getPen(false)));
+        pasted->setSelected(false);
+        pasted->setUpdateEnabled(true);
+        pasted->update();
+        container->adjustBorders(pasted);
+
+        undo.addUndoable(pasted);
+    }
+
+    container->setAutoUpdateBorders(autoUpdateBorders);
+    viewport->notifyChanged();
+}
+
 
 
 /**
  * Create layers in destination graphic corresponding to entity to be copied
  *
+ * @param layersDict receives the layer of the destination graphic for
+ *      every layer of the source.
  **/
-bool RS_Modification::pasteLayers(RS_Graphic* source) {
+bool RS_Modification::pasteLayers(RS_Graphic* source, LayersDict& layersDict) {
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers");
 
@@ -770,52 +867,74 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
 
         // add layers if absent
         QString ln = l->getName();
-        if (!graphic->findLayer(ln)) {
-            graphic->addLayer(l->clone());
+        RS_Layer* target = graphic->findLayer(ln);
+        if (!target) {
+            target = l->clone();
+            graphic->addLayer(target);
             RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: layer added: %s", ln.toLatin1().data());
         }
+        layersDict.insert(l, target);
     }
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: OK");
     return true;
 }
 
+/**
+ * @return layer of the destination graphic for the layer of a source entity
+ */
+RS_Layer* RS_Modification::pasteLayer(RS_Entity* entity, LayersDict& layersDict) const {
+    RS_Layer* sourceLayer = entity->getLayer();
+    if (sourceLayer == nullptr) {
+        return nullptr;
+    }
+    auto it = layersDict.constFind(sourceLayer);
+    if (it != layersDict.cend()) {
+        return it.value();
+    }
+    // entity on a layer outside of the source layer list
+    RS_Layer* layer = graphic->getLayerList()->find(sourceLayer->getName());
+    layersDict.insert(sourceLayer, layer);
+    return layer;
+}
+
 
 
 /**
  * Create inserts and blocks in destination graphic corresponding to entity to be copied
  *
+ * @return the insert (or entity) added to containerToPaste, nullptr on failure
  **/
-bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* containerToPaste, QHash<QString, QString>blocksDict, RS_Vector insertionPoint) {
+RS_Entity* RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* containerToPaste, QHash<QString, QString>blocksDict,
+                                           LayersDict& layersDict, RS_Vector insertionPoint) {
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert");
 
     auto* insert = dynamic_cast<RS_Insert*>(entity);
     if (insert == nullptr) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: no container to process");
-        return false;
+        return nullptr;
     }
 
     // get block for this insert object
     RS_Block* insertBlock = insert->getBlockForInsert();
     if (insertBlock == nullptr) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: no block to process");
-        return false;
+        return nullptr;
     }
     // get name for this insert object
     QString name_old = insertBlock->getName();
     QString name_new = name_old;
     if (name_old != insert->getName()) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: block and insert names don't coincide");
-        return false;
+        return nullptr;
     }
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: processing container: %s", name_old.toLatin1().data());
     // rename if needed
     if (graphic->findBlock(name_old)) {
         if (insertBlock->getParent() == graphic) {
             // If block is already in graphic, only paste a new insert
-            pasteEntity(entity, container);
-            return true;
+            return pasteEntity(entity, containerToPaste, layersDict);
         } else {
             name_new = graphic->getBlockList()->newName(name_old);
             RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: new block name: %s", name_new.toLatin1().data());
@@ -831,11 +950,10 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     containerToPaste->addEntity(insertClone);
 
     // set the same layer in clone as in source
-    QString ln = entity->getLayer()->getName();
-    RS_Layer* layer = graphic->getLayerList()->find(ln);
+    RS_Layer* layer = pasteLayer(entity, layersDict);
     if (!layer) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
-        return false;
+        return nullptr;
     }
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", layer->getName().toLatin1().data());
     insertClone->setLayer(layer);
@@ -858,14 +976,14 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
 
         if (e->rtti() == RS2::EntityInsert) {
             RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: process sub-insert for %s", ((RS_Insert*)e)->getName().toLatin1().data());
-            if (!pasteContainer(e, blockClone, blocksDict, ip)) {
+            if (!pasteContainer(e, blockClone, blocksDict, layersDict, ip)) {
                 RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to paste entity to sub-insert");
-                return false;
+                return nullptr;
             }
         } else {
-            if (!pasteEntity(e, blockClone)) {
+            if (!pasteEntity(e, blockClone, layersDict)) {
                 RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to paste entity");
-                return false;
+                return nullptr;
             }
         }
     }
@@ -874,33 +992,34 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     insertClone->setSelected(false);
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: OK");
-    return true;
+    return insertClone;
 }
 
 /**
  * Paste entity in supplied container
  *
+ * @return the pasted clone, nullptr on failure
  **/
-bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* containerToPaste) {
+RS_Entity* RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* containerToPaste, LayersDict& layersDict) {
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity");
 
     if (!entity) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteEntity: no entity to process");
-        return false;
+        return nullptr;
     }
 
-    // create entity copy to paste
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity ID/flag: %s", getIdFlagString(entity).c_str());
-    RS_Entity* e = entity->clone();
-
     // set the same layer in clone as in source
-    QString ln = entity->getLayer()->getName();
-    RS_Layer* layer = graphic->getLayerList()->find(ln); // fixme - perf- layer search is not needed if copy paste within the same document
+    RS_Layer* layer = pasteLayer(entity, layersDict);
     if (!layer) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
-        return false;
+        return nullptr;
     }
+
+    // create entity copy to paste
+    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity ID/flag: %s", getIdFlagString(entity).c_str());
+    RS_Entity* e = entity->clone();
+
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", layer->getName().toLatin1().data());
     e->setLayer(layer);
     e->setPen(entity->getPen(false));
@@ -912,7 +1031,7 @@ bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* contain
     e->setSelected(false);
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity: OK");
-    return true;
+    return e;
 }
 
 
@@ -1724,27 +1843,24 @@ bool RS_Modification::move(RS_MoveData &data, bool previewOnly, [[maybe_unused]]
 
 
 bool RS_Modification::move(RS_MoveData& data, const std::vector<RS_Entity*> &entitiesList, bool forPreviewOnly, bool keepSelected) {
-
     int numberOfCopies = data.obtainNumberOfCopies();
-    std::vector<RS_Entity*> clonesList;
-
-    for(auto e: entitiesList){
-        // Create new entities
-        for (int num = 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
+    std::vector<RS_Entity*> clonesList = createTransformedClones(entitiesList, numberOfCopies, forPreviewOnly, false,
+        [&data](RS_Entity* ec, int num) {
             ec->move(data.offset*num);
-            clonesList.push_back(ec);
-        }
-    }
+        });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
-    deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
-    clonesList.clear();
+    commitClones(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
     return true;
 }
 
 RS_Entity *RS_Modification::getClone(bool forPreviewOnly, const RS_Entity *e) const {
+    bool textsAsDraft = forPreviewOnly && LC_GET_ONE_BOOL("Render","DrawTextsAsDraftInPreview", true);
+    return getClone(forPreviewOnly, e, textsAsDraft);
+}
+
+RS_Entity *RS_Modification::getClone(bool forPreviewOnly, const RS_Entity *e, bool textsAsDraft) const {
     RS_Entity* result = nullptr;
     if (forPreviewOnly){
         int rtti = e->rtti();
@@ -1752,8 +1868,7 @@ RS_Entity *RS_Modification::getClone(bool forPreviewOnly, const RS_Entity *e) co
             case RS2::EntityText:
             case RS2::EntityMText:{
                 // fixme - sand - ucs - BAD dependency, rework.
-                bool  drawTextAsDraftInPreview = LC_GET_ONE_BOOL("Render","DrawTextsAsDraftInPreview", true);
-                if (drawTextAsDraftInPreview) {
+                if (textsAsDraft) {
                     result = e->cloneProxy();
                 }
                 else{
@@ -1776,6 +1891,113 @@ RS_Entity *RS_Modification::getClone(bool forPreviewOnly, const RS_Entity *e) co
     return result;
 }
 
+/**
+ * Creates numberOfCopies clones of each entity and transforms them by the given function, that gets the clone and
+ * the number of the copy (starting from 1). Clones are returned in the order of entities.
+ * For large lists, entities that depend only on own data are cloned and transformed by parallel chunks, so the
+ * transform function should only read shared data. Inserts, texts, dimensions, hatches and other entities that
+ * use fonts, blocks, patterns or settings are processed in the calling thread.
+ */
+std::vector<RS_Entity*> RS_Modification::createTransformedClones(const std::vector<RS_Entity*>& entitiesList, int numberOfCopies,
+                                                                 bool forPreviewOnly, bool anisotropicScaling,
+                                                                 const std::function<void(RS_Entity*, int)>& transform) const {
+    // settings are read once, as they are not accessible from worker threads
+    const bool textsAsDraft = forPreviewOnly && LC_GET_ONE_BOOL("Render","DrawTextsAsDraftInPreview", true);
+    const size_t entitiesCount = entitiesList.size();
+    const size_t copies = static_cast<size_t>(std::max(numberOfCopies, 0));
+    std::vector<RS_Entity*> result(entitiesCount * copies, nullptr);
+
+    auto cloneEntity = [&](size_t i) {
+        const RS_Entity* e = entitiesList[i];
+        for (size_t num = 1; num <= copies; num++) {
+            RS_Entity* ec = getClone(forPreviewOnly, e, textsAsDraft);
+            transform(ec, static_cast<int>(num));
+            result[i * copies + num - 1] = ec;
+        }
+    };
+    auto isParallelTransformable = [anisotropicScaling](const RS_Entity* e) {
+        switch (e->rtti()) {
+            case RS2::EntityPoint:
+            case RS2::EntityLine:
+            case RS2::EntityArc:
+            case RS2::EntityCircle:
+            case RS2::EntityEllipse:
+            case RS2::EntitySolid:
+            case RS2::EntitySpline:
+            case RS2::EntitySplinePoints:
+            case RS2::EntityParabola:
+                return true;
+            case RS2::EntityPolyline:
+                // polyline reports anisotropic scaling of arcs to the user
+                return !anisotropicScaling;
+            default:
+                return false;
+        }
+    };
+
+    const int threadsCount = QThread::idealThreadCount();
+    const bool parallel = result.size() >= PARALLEL_CLONES_MIN && threadsCount > 1;
+    if (parallel) {
+        std::atomic<size_t> nextChunk{0};
+        auto cloneChunks = [&]() {
+            for (size_t first = nextChunk.fetch_add(PARALLEL_CHUNK_SIZE); first < entitiesCount;
+                 first = nextChunk.fetch_add(PARALLEL_CHUNK_SIZE)) {
+                size_t last = std::min(first + PARALLEL_CHUNK_SIZE, entitiesCount);
+                for (size_t i = first; i < last; i++) {
+                    if (isParallelTransformable(entitiesList[i])) {
+                        cloneEntity(i);
+                    }
+                }
+            }
+        };
+        QThreadPool pool;
+        for (int i = 1; i < threadsCount; i++) {
+            pool.start(cloneChunks);
+        }
+        cloneChunks();
+        pool.waitForDone();
+    }
+    for (size_t i = 0; i < entitiesCount; i++) {
+        if (!parallel || !isParallelTransformable(entitiesList[i])) {
+            cloneEntity(i);
+        }
+    }
+    return result;
+}
+
+/**
+ * Replaces original entities by transformed clones (or just adds clones to the preview) in one undo cycle.
+ * Undoables are added at once, and the borders of the container are rebuilt on demand instead of full
+ * recalculation.
+ */
+void RS_Modification::commitClones(const std::vector<RS_Entity*>& clonesList, const std::vector<RS_Entity*>& originalEntities,
+                                   bool forPreviewOnly, bool deleteOriginals) {
+    if (forPreviewOnly) {
+        deleteOriginalAndAddNewEntities(clonesList, originalEntities, true, deleteOriginals);
+        return;
+    }
+    LC_UndoSection undo(document, viewport, handleUndo);
+    std::vector<RS_Undoable*> undoables;
+    undoables.reserve(clonesList.size() + (deleteOriginals ? originalEntities.size() : 0));
+    for (RS_Entity* e: originalEntities) {
+        e->setSelected(false);
+        if (deleteOriginals) {
+            e->changeUndoState();
+            undoables.push_back(e);
+        }
+    }
+    for (RS_Entity* e: clonesList) {
+        if (e != nullptr) {
+            container->addEntity(e);
+            undoables.push_back(e);
+        }
+    }
+    undo.addUndoables(undoables);
+
+    container->invalidateBorders();
+    viewport->notifyChanged();
+}
+
 void RS_Modification::setupModifiedClones(
     std::vector<RS_Entity *> &addList, const LC_ModifyOperationFlags &data, bool forPreviewOnly, bool keepSelected) const {
     if (!forPreviewOnly && (data.useCurrentLayer || data.useCurrentAttributes)){
@@ -1809,32 +2031,21 @@ void RS_Modification::setupModifiedClones(
 bool RS_Modification::alignRef(LC_AlignRefData & data, const std::vector<RS_Entity*> &entitiesList, bool forPreviewOnly, bool keepSelected) {
 
     int numberOfCopies = 1; /*data.obtainNumberOfCopies();*/
-    std::vector<RS_Entity*> clonesList;
-
-    RS_Vector offset = data.offset;
-
-    // too slow:
-    for(auto e: entitiesList){
-        // Create new entities
-        for (int num = 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
+    bool doScale = data.scale && LC_LineMath::isMeaningful(data.scaleFactor - 1.0);
+    std::vector<RS_Entity*> clonesList = createTransformedClones(entitiesList, numberOfCopies, forPreviewOnly, false,
+        [&data, doScale](RS_Entity* ec, int num) {
             ec->rotate(data.rotationCenter, data.rotationAngle);
 
-            if (data.scale && LC_LineMath::isMeaningful(data.scaleFactor - 1.0)){
+            if (doScale){
                 ec->scale(data.rotationCenter, data.scaleFactor);
             }
 
-            ec->move(offset*num);
-
-            clonesList.push_back(ec);
-        }
-    }
+            ec->move(data.offset*num);
+        });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
-    deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
-    clonesList.clear();
+    commitClones(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
     return true;
 }
 
@@ -1900,14 +2111,11 @@ bool RS_Modification::rotate(RS_RotateData &data, bool forPreviewOnly, bool keep
 }
 
 bool RS_Modification::rotate(RS_RotateData& data, const std::vector<RS_Entity*> &entitiesList, bool forPreviewOnly, bool keepSelected) {
-    std::vector<RS_Entity *> clonesList;
     // Create new entities
 
     int numberOfCopies = data.obtainNumberOfCopies();
-    for (auto e: entitiesList) {
-        for (int num = 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
+    std::vector<RS_Entity *> clonesList = createTransformedClones(entitiesList, numberOfCopies, forPreviewOnly, false,
+        [&data](RS_Entity* ec, int num) {
             double rotationAngle = data.angle * num;
             ec->rotate(data.center, rotationAngle);
 
@@ -1927,15 +2135,11 @@ bool RS_Modification::rotate(RS_RotateData& data, const std::vector<RS_Entity*>
                 }
                 ec->rotate(rotatedRefPoint, secondRotationAngle);
             }
-
-            clonesList.push_back(ec);
-        }
-    }
+        });
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
-    deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
-    clonesList.clear();
-    
+    commitClones(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
+
     return true;
 }
 
@@ -1959,7 +2163,7 @@ bool RS_Modification::scale(RS_ScaleData& data, bool forPreviewOnly, const bool
  * modification.
  */
 bool RS_Modification::scale(RS_ScaleData& data, const std::vector<RS_Entity*> &entitiesList, bool forPreviewOnly, const bool keepSelected) {
-    std::vector<RS_Entity*> selectedList,clonesList;
+    std::vector<RS_Entity*> selectedList;
 
     for(auto ec: entitiesList){
         if ( !data.isotropicScaling ) {
@@ -1992,19 +2196,14 @@ bool RS_Modification::scale(RS_ScaleData& data, const std::vector<RS_Entity*> &e
     int numberOfCopies = data.obtainNumberOfCopies();
 
     // Create new entities
-    for(RS_Entity* e: selectedList) {
-        if (e != nullptr) {
-            for (int num= 1; num <= numberOfCopies; num++) {
-                RS_Entity* ec = getClone(forPreviewOnly, e);
-                ec->scale(data.referencePoint, RS_Math::pow(data.factor, num));
-                clonesList.push_back(ec);
-            }
-        }
-    }
+    bool anisotropic = !RS_Math::equal(data.factor.x, data.factor.y);
+    std::vector<RS_Entity*> clonesList = createTransformedClones(selectedList, numberOfCopies, forPreviewOnly, anisotropic,
+        [&data](RS_Entity* ec, int num) {
+            ec->scale(data.referencePoint, RS_Math::pow(data.factor, num));
+        });
     selectedList.clear();
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
-    deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
-    clonesList.clear();
+    commitClones(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
 
     return true; 
 }
@@ -2025,25 +2224,18 @@ bool RS_Modification::mirror(RS_MirrorData& data, bool keepSelected) {
 
 bool RS_Modification::mirror(RS_MirrorData& data, const std::vector<RS_Entity*> &entitiesList, bool forPreviewOnly, bool keepSelected) {
 
-    std::vector<RS_Entity*> clonesList;
-
 //    int numberOfCopies = obtainNumberOfCopies(data);
     int numberOfCopies = 1; // fixme - think about support of multiple copies.... may it be be something like moving the central point of selection? Like mirror+move?
 
     // Create new entities
-
-    for(auto e: entitiesList){
-        for (int num=1; num<=numberOfCopies; ++num) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
+    std::vector<RS_Entity*> clonesList = createTransformedClones(entitiesList, numberOfCopies, forPreviewOnly, false,
+        [&data](RS_Entity* ec, [[maybe_unused]] int num) {
             ec->mirror(data.axisPoint1, data.axisPoint2);
-            clonesList.push_back(ec);
-        }
-    }
+        });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
-    deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
-    clonesList.clear();
+    commitClones(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
     return true;
 }
 
@@ -2062,16 +2254,11 @@ bool RS_Modification::rotate2(RS_Rotate2Data& data,[[maybe_unused]] bool forPrev
 
 bool RS_Modification::rotate2(RS_Rotate2Data& data, const std::vector<RS_Entity*> &entitiesList, bool forPreviewOnly, bool keepSelected) {
 
-    std::vector<RS_Entity*> clonesList;
-
     int numberOfCopies = data.obtainNumberOfCopies();
 
     // Create new entities
-
-    for(auto e: entitiesList){
-        for (int num= 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
+    std::vector<RS_Entity*> clonesList = createTransformedClones(entitiesList, numberOfCopies, forPreviewOnly, false,
+        [&data](RS_Entity* ec, int num) {
             double angle1ForCopy = /*data.sameAngle1ForCopies ?  data.angle1 :*/ data.angle1 * num;
             double angle2ForCopy = data.sameAngle2ForCopies ?  data.angle2 : data.angle2 * num;
 
@@ -2081,14 +2268,10 @@ bool RS_Modification::rotate2(RS_Rotate2Data& data, const std::vector<RS_Entity*
             center2.rotate(data.center1, angle1ForCopy);
 
             ec->rotate(center2, angle2ForCopy);
-
-            clonesList.push_back(ec);
-        }
-    }
+        });
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
-    deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
-    clonesList.clear();
+    commitClones(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
     return true;
 }
 
@@ -2123,29 +2306,20 @@ bool RS_Modification::moveRotate(RS_MoveRotateData& data, bool previewOnly, [[ma
 }
 
 bool RS_Modification::moveRotate(RS_MoveRotateData &data, const std::vector<RS_Entity*> &entitiesList, bool forPreviewOnly, bool keepSelected){
-    std::vector<RS_Entity*> clonesList;
-
     int numberOfCopies = data.obtainNumberOfCopies();
 
     // Create new entities
-    for(auto e: entitiesList){
-        for (int num=1; num <= numberOfCopies; ++num) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
+    std::vector<RS_Entity*> clonesList = createTransformedClones(entitiesList, numberOfCopies, forPreviewOnly, false,
+        [&data](RS_Entity* ec, int num) {
             const RS_Vector &offset = data.offset * num;
             ec->move(offset);
             double angleForCopy = data.sameAngleForCopies ?  data.angle : data.angle * num;
             ec->rotate(data.referencePoint + offset, angleForCopy);
-
-            clonesList.push_back(ec);
-        }
-    }
+        });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
-
-    deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
-    clonesList.clear();
+    commitClones(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
     return true;
 }
 
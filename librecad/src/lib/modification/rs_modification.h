@@ -26,6 +26,11 @@
 
 #ifndef RS_MODIFICATION_H
 #define RS_MODIFICATION_H
+#include <functional>
+#include <vector>
+
+#include <QHash>
+#include <QSet>
 #include <QString>
 
 #include "rs_pen.h"
@@ -33,8 +38,10 @@
 
 class RS_Arc;
 class RS_AtomicEntity;
+class RS_Block;
 class RS_Entity;
 class RS_EntityContainer;
+class RS_Layer;
 class RS_MText;
 class RS_Text;
 class RS_Line;
@@ -373,16 +380,33 @@ public:
     bool alignRef(LC_AlignRefData& data, const std::vector<RS_Entity*>& entitiesList, bool forPreviewOnly,
                   bool keepSelected);
 private:
-    void copyEntity(RS_Entity* e, const RS_Vector& ref, bool cut);
-    void copyLayers(RS_Entity* e);
-    void copyBlocks(RS_Entity* e);
-    bool pasteLayers(RS_Graphic* source);
-    bool pasteContainer(RS_Entity* entity, RS_EntityContainer* containerToPaste, QHash<QString, QString> blocksDict,
-                        RS_Vector insertionPoint);
-    bool pasteEntity(RS_Entity* entity, RS_EntityContainer* containerToPaste);
+    /** Layers and blocks already transferred to the clipboard by one copy(). */
+    struct CopyState {
+        QHash<RS_Layer*, RS_Layer*> layers;
+        QSet<RS_Block*> layersOfBlocks;
+        QSet<RS_Block*> blocks;
+    };
+    /** Source layer to the layer of this graphic, resolved once per paste. */
+    using LayersDict = QHash<RS_Layer*, RS_Layer*>;
+
+    void copyEntity(RS_Entity* e, const RS_Vector& ref, bool cut, CopyState& state);
+    RS_Layer* copyLayers(RS_Entity* e, CopyState& state);
+    void copyBlocks(RS_Entity* e, CopyState& state);
+    void pasteEntities(const RS_PasteData& data, const RS_Vector& factor, RS_Graphic& source,
+                       LayersDict& layersDict, QHash<QString, QString>& blocksDict);
+    bool pasteLayers(RS_Graphic* source, LayersDict& layersDict);
+    RS_Layer* pasteLayer(RS_Entity* entity, LayersDict& layersDict) const;
+    RS_Entity* pasteContainer(RS_Entity* entity, RS_EntityContainer* containerToPaste, QHash<QString, QString> blocksDict,
+                              LayersDict& layersDict, RS_Vector insertionPoint);
+    RS_Entity* pasteEntity(RS_Entity* entity, RS_EntityContainer* containerToPaste, LayersDict& layersDict);
     void deselectOriginals(bool remove);
     void deselectOriginals(const std::vector<RS_Entity*>& entitiesList, bool remove);
     void addNewEntities(const std::vector<RS_Entity*>& addList, bool forceUndoable = false);
+    std::vector<RS_Entity*> createTransformedClones(const std::vector<RS_Entity*>& entitiesList, int numberOfCopies,
+                                                    bool forPreviewOnly, bool anisotropicScaling,
+                                                    const std::function<void(RS_Entity*, int)>& transform) const;
+    void commitClones(const std::vector<RS_Entity*>& clonesList, const std::vector<RS_Entity*>& originalEntities,
+                      bool forPreviewOnly, bool deleteOriginals);
     bool explodeTextIntoLetters(RS_MText* text, std::vector<RS_Entity*>& addList);
     bool explodeTextIntoLetters(RS_Text* text, std::vector<RS_Entity*>& addList);
 protected:
@@ -402,6 +426,7 @@ protected:
                              bool forPreviewOnly, bool keepSelected) const;
 
     RS_Entity* getClone(bool forPreviewOnly, const RS_Entity* e) const;
+    RS_Entity* getClone(bool forPreviewOnly, const RS_Entity* e, bool textsAsDraft) const;
 };
 
 #endif
@@ -0,0 +1,534 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "main.h"
+
+#include "console_benchmark.h"
+#include "lc_arctessellationcache.h"
+#include "lc_graphicviewport.h"
+#include "lc_printviewportrenderer.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_debug.h"
+#include "rs_filterdxfrw.h"
+#include "rs_fontlist.h"
+#include "rs_graphic.h"
+#include "rs_hatch.h"
+#include "rs_insert.h"
+#include "rs_line.h"
+#include "rs_modification.h"
+#include "rs_painter.h"
+#include "rs_patternlist.h"
+#include "rs_selection.h"
+#include "rs_settings.h"
+#include "rs_spline.h"
+#include "rs_system.h"
+#include "rs_text.h"
+
+namespace {
+
+/**
+ * Content of the generated drawing. Sizes are chosen to resemble
+ * a large real-world plan.
+ */
+struct LC_SyntheticDrawingSpec {
+    int lines = 100000;
+    int inserts = 1000;
+    int blockEntities = 20;
+    int hatches = 200;
+    int texts = 1000;
+    int splines = 500;
+    int arcs = 5000;
+};
+
+struct LC_BenchmarkOptions {
+    int iterations = 5;
+    int queries = 100;
+    QSize resolution{1920, 1080};
+};
+
+const double SYNTHETIC_EXTENT = 10000.0;
+const char* const SYNTHETIC_BLOCK = "BENCHMARK_BLOCK";
+
+template<typename Function>
+double measureMs(Function&& function) {
+    QElapsedTimer timer;
+    timer.start();
+    function();
+    return timer.nsecsElapsed() / 1.0e6;
+}
+
+QJsonObject summarize(std::vector<double> samples) {
+    QJsonObject result;
+    if (samples.empty()) {
+        return result;
+    }
+    QJsonArray all;
+    for (double s: samples) {
+        all.append(s);
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    double median = (n % 2 == 1) ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    result["min_ms"] = samples.front();
+    result["max_ms"] = samples.back();
+    result["median_ms"] = median;
+    result["mean_ms"] = mean;
+    result["samples_ms"] = all;
+    return result;
+}
+
+RS_Vector randomPoint(std::mt19937& rng, const RS_Vector& min, const RS_Vector& max) {
+    std::uniform_real_distribution<double> dx(min.x, max.x);
+    std::uniform_real_distribution<double> dy(min.y, max.y);
+    // explicit sequencing keeps the sequence identical across compilers
+    double x = dx(rng);
+    double y = dy(rng);
+    return {x, y};
+}
+
+template<class T>
+T* addToContainer(RS_EntityContainer* container, T* entity) {
+    entity->setLayerToActive();
+    entity->setPenToActive();
+    container->addEntity(entity);
+    return entity;
+}
+
+void addBenchmarkBlock(RS_Graphic* graphic, int entitiesCount) {
+    auto block = new RS_Block(graphic, RS_BlockData(SYNTHETIC_BLOCK, RS_Vector(0., 0.), false));
+    for (int i = 0; i < entitiesCount; i++) {
+        double a = 2. * M_PI * i / std::max(entitiesCount, 1);
+        RS_Vector p(5. * std::cos(a), 5. * std::sin(a));
+        if (i % 2 == 0) {
+            addToContainer(block, new RS_Line(block, RS_Vector(0., 0.), p));
+        } else {
+            addToContainer(block, new RS_Circle(block, RS_CircleData(p, 1.)));
+        }
+    }
+    graphic->addBlock(block, false);
+}
+
+void addSquareHatch(RS_Graphic* graphic, const RS_Vector& corner, double size, bool solid) {
+    auto hatch = new RS_Hatch(graphic, RS_HatchData(solid, 1.0, 0.0, solid ? "SOLID" : "ANSI31"));
+    hatch->setLayerToActive();
+    hatch->setPenToActive();
+
+    auto loop = new RS_EntityContainer(hatch);
+    loop->setPen(RS_Pen(RS2::FlagInvalid));
+    const RS_Vector vertices[] = {corner, corner + RS_Vector(size, 0.),
+                                  corner + RS_Vector(size, size), corner + RS_Vector(0., size)};
+    for (int i = 0; i < 4; i++) {
+        loop->addEntity(new RS_Line(loop, vertices[i], vertices[(i + 1) % 4]));
+    }
+    hatch->addEntity(loop);
+    graphic->addEntity(hatch);
+    hatch->update();
+}
+
+/**
+ * Fills the document with a deterministic mix of entities.
+ */
+void generateDrawing(RS_Graphic* graphic, const LC_SyntheticDrawingSpec& spec) {
+    std::mt19937 rng(20250101);
+    std::uniform_real_distribution<double> length(1., 100.);
+    std::uniform_real_distribution<double> angle(0., 2. * M_PI);
+    RS_Vector min(0., 0.);
+    RS_Vector max(SYNTHETIC_EXTENT, SYNTHETIC_EXTENT);
+
+    for (int i = 0; i < spec.lines; i++) {
+        RS_Vector start = randomPoint(rng, min, max);
+        double a = angle(rng);
+        RS_Vector end = start + RS_Vector::polar(length(rng), a);
+        addToContainer(graphic, new RS_Line(graphic, start, end));
+    }
+
+    if (spec.inserts > 0) {
+        addBenchmarkBlock(graphic, spec.blockEntities);
+        for (int i = 0; i < spec.inserts; i++) {
+            RS_Vector position = randomPoint(rng, min, max);
+            RS_InsertData data(SYNTHETIC_BLOCK, position, RS_Vector(1., 1.), angle(rng),
+                               1, 1, RS_Vector(0., 0.), nullptr, RS2::NoUpdate);
+            addToContainer(graphic, new RS_Insert(graphic, data))->update();
+        }
+    }
+
+    for (int i = 0; i < spec.hatches; i++) {
+        RS_Vector corner = randomPoint(rng, min, max);
+        addSquareHatch(graphic, corner, 50., i % 2 == 0);
+    }
+
+    for (int i = 0; i < spec.texts; i++) {
+        RS_Vector position = randomPoint(rng, min, max);
+        RS_TextData data(position, position, 2.5, 1.0, RS_TextData::VABaseline, RS_TextData::HALeft,
+                         RS_TextData::None, QString("Text %1").arg(i), "standard", angle(rng),
+                         RS2::NoUpdate);
+        addToContainer(graphic, new RS_Text(graphic, data))->update();
+    }
+
+    for (int i = 0; i < spec.splines; i++) {
+        RS_Vector start = randomPoint(rng, min, max);
+        auto spline = new RS_Spline(graphic, RS_SplineData(3, false));
+        for (int j = 0; j < 6; j++) {
+            spline->addControlPoint(start + RS_Vector(j * 10., (j % 2) * 15.));
+        }
+        addToContainer(graphic, spline)->update();
+    }
+
+    // holes with slots and fillets, as in mechanical drawings
+    std::uniform_real_distribution<double> radius(0.5, 20.);
+    for (int i = 0; i < spec.arcs; i++) {
+        RS_Vector center = randomPoint(rng, min, max);
+        double r = radius(rng);
+        double a = angle(rng);
+        addToContainer(graphic, new RS_Circle(graphic, RS_CircleData(center, r)));
+        addToContainer(graphic, new RS_Arc(graphic, RS_ArcData(center, 1.5 * r, a, a + M_PI, false)));
+    }
+
+    graphic->calculateBorders();
+}
+
+std::unique_ptr<RS_Graphic> readDxf(const QString& fileName, double* elapsedMs) {
+    auto graphic = std::make_unique<RS_Graphic>();
+    graphic->newDoc();
+    bool ok = false;
+    double ms = measureMs([&graphic, &fileName, &ok]{
+        RS_FilterDXFRW filter;
+        ok = filter.fileImport(*graphic, fileName, RS2::FormatDXFRW);
+    });
+    if (!ok) {
+        return {};
+    }
+    if (elapsedMs != nullptr) {
+        *elapsedMs = ms;
+    }
+    graphic->calculateBorders();
+    return graphic;
+}
+
+/**
+ * Renders the whole drawing. With interpolated arcs, arcs and circles are drawn as
+ * line segments, and their shapes are reused from the arc cache, if it's given.
+ */
+double renderFullView(RS_Graphic* graphic, const QSize& size, bool interpolateArcs = false,
+                      LC_ArcTessellationCache* arcCache = nullptr) {
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    return measureMs([graphic, &image, &size, interpolateArcs, arcCache]{
+        RS_Painter painter(&image);
+        painter.setRenderArcsInterpolate(interpolateArcs);
+        painter.setRenderCirclesSameAsArcs(interpolateArcs);
+        painter.setArcTessellationCache(arcCache);
+        painter.setBackground(Qt::white);
+        painter.eraseRect(0, 0, size.width(), size.height());
+
+        LC_GraphicViewport viewport;
+        viewport.setSize(size.width(), size.height());
+        viewport.setBorders(5, 5, 5, 5);
+        viewport.setContainer(graphic);
+        viewport.loadSettings();
+        viewport.zoomAuto(false);
+
+        LC_PrintViewportRenderer renderer(&viewport, &painter);
+        renderer.loadSettings();
+        renderer.setBackground(Qt::white);
+        renderer.render();
+        painter.end();
+    });
+}
+
+/**
+ * Runs all timed operations on one drawing. The file is read anew for
+ * every iteration, so modifications never accumulate across samples.
+ */
+QJsonObject benchmarkDrawing(RS_Graphic* reference, const QString& sourceFile,
+                             const QString& scratchFile, const LC_BenchmarkOptions& options) {
+    std::vector<double> writeMs, readMs, renderMs, nearestMs, intersectionMs, selectMs, moveMs, rotateMs;
+    std::vector<double> renderArcsMs, renderArcsCachedMs;
+
+    for (int i = 0; i < options.iterations; i++) {
+        writeMs.push_back(measureMs([reference, &scratchFile]{
+            RS_FilterDXFRW filter;
+            filter.fileExport(*reference, scratchFile, RS2::FormatDXFRW);
+        }));
+    }
+
+    const QString& readFile = sourceFile.isEmpty() ? scratchFile : sourceFile;
+    for (int i = 0; i < options.iterations; i++) {
+        double ms = 0.;
+        std::unique_ptr<RS_Graphic> graphic = readDxf(readFile, &ms);
+        if (graphic == nullptr) {
+            LC_ERR << "benchmark: failed to read" << readFile;
+            break;
+        }
+        readMs.push_back(ms);
+
+        renderMs.push_back(renderFullView(graphic.get(), options.resolution));
+        renderArcsMs.push_back(renderFullView(graphic.get(), options.resolution, true));
+        // redraw of the unchanged view, after the first draw has filled the cache
+        LC_ArcTessellationCache arcCache;
+        renderFullView(graphic.get(), options.resolution, true, &arcCache);
+        renderArcsCachedMs.push_back(renderFullView(graphic.get(), options.resolution, true, &arcCache));
+
+        // same query points in every iteration
+        std::mt19937 rng(4242);
+        std::vector<RS_Vector> queries;
+        for (int q = 0; q < options.queries; q++) {
+            queries.push_back(randomPoint(rng, graphic->getMin(), graphic->getMax()));
+        }
+        nearestMs.push_back(measureMs([&graphic, &queries]{
+            for (const RS_Vector& p: queries) {
+                double dist = 0.;
+                graphic->getNearestEntity(p, &dist, RS2::ResolveAllButTextImage);
+            }
+        }));
+        intersectionMs.push_back(measureMs([&graphic, &queries]{
+            for (const RS_Vector& p: queries) {
+                double dist = 0.;
+                graphic->getNearestIntersection(p, &dist);
+            }
+        }));
+
+        LC_GraphicViewport viewport;
+        viewport.setSize(options.resolution.width(), options.resolution.height());
+        viewport.setContainer(graphic.get());
+        viewport.loadSettings();
+        viewport.zoomAuto(false);
+
+        RS_Selection selection(*graphic, &viewport);
+        selectMs.push_back(measureMs([&selection]{
+            selection.selectAll(true);
+        }));
+
+        RS_Modification modification(*graphic, &viewport, false);
+        RS_MoveData moveData;
+        moveData.offset = RS_Vector(10., 5.);
+        moveData.number = 1;
+        moveMs.push_back(measureMs([&modification, &moveData]{
+            modification.move(moveData);
+        }));
+
+        RS_RotateData rotateData;
+        rotateData.center = (graphic->getMin() + graphic->getMax()) * 0.5;
+        rotateData.refPoint = rotateData.center;
+        rotateData.angle = M_PI / 6.;
+        rotateData.number = 1;
+        rotateMs.push_back(measureMs([&modification, &rotateData]{
+            modification.rotate(rotateData, false, true);
+        }));
+    }
+
+    QJsonObject results;
+    results["dxf_write"] = summarize(writeMs);
+    results["dxf_read"] = summarize(readMs);
+    results["render"] = summarize(renderMs);
+    results["render_arcs"] = summarize(renderArcsMs);
+    results["render_arcs_cached"] = summarize(renderArcsCachedMs);
+    results["snap_nearest"] = summarize(nearestMs);
+    results["snap_intersection"] = summarize(intersectionMs);
+    results["select_all"] = summarize(selectMs);
+    results["move"] = summarize(moveMs);
+    results["rotate"] = summarize(rotateMs);
+    return results;
+}
+
+QJsonObject describeDrawing(const QString& name, RS_Graphic* graphic) {
+    QJsonObject drawing;
+    drawing["name"] = name;
+    drawing["entities"] = static_cast<int>(graphic->count());
+    drawing["entities_deep"] = static_cast<int>(graphic->countDeep());
+    drawing["blocks"] = static_cast<int>(graphic->countBlocks());
+    return drawing;
+}
+
+QSize parseResolution(const QString& arg, const QSize& defaultSize) {
+    QRegularExpression re("^(?<width>\\d+)[x|X]{1}(?<height>\\d+)$");
+    QRegularExpressionMatch match = re.match(arg);
+    if (!match.hasMatch()) {
+        return defaultSize;
+    }
+    return {match.captured("width").toInt(), match.captured("height").toInt()};
+}
+
+int intOption(const QCommandLineParser& parser, const QCommandLineOption& option, int defaultValue) {
+    bool ok = false;
+    int value = parser.value(option).toInt(&ok);
+    return (ok && value >= 0) ? value : defaultValue;
+}
+}
+
+/////////
+/// \brief console_benchmark is called if librecad is started
+/// as console benchmark tool. Loading, rendering, snapping and
+/// modification are timed on a generated drawing and on the given
+/// DXF files; the results are written as JSON.
+/// \param argc
+/// \param argv
+/// \return
+///
+int console_benchmark(int argc, char* argv[])
+{
+    RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
+
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("LibreCAD");
+    QCoreApplication::setApplicationName("LibreCAD");
+    QCoreApplication::setApplicationVersion(XSTR(LC_VERSION));
+
+    QFileInfo prgInfo(QFile::decodeName(argv[0]));
+    QString prgDir(prgInfo.absolutePath());
+    RS_Settings::init(app.organizationName(), app.applicationName());
+    RS_SYSTEM->init(app.applicationName(), app.applicationVersion(),
+        XSTR(QC_APPDIR), prgDir.toLatin1().data());
+
+    QCommandLineParser parser;
+
+    QString appDesc = "\nbenchmark usage: " + prgInfo.filePath() + " benchmark [options] [<dxf_files>]\n";
+    appDesc += "\nTime loading, rendering, snapping and modification of a generated drawing";
+    appDesc += "\nand of the given DXF files. Results are written as JSON.";
+    parser.setApplicationDescription(appDesc);
+
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    LC_SyntheticDrawingSpec spec;
+    LC_BenchmarkOptions options;
+
+    QCommandLineOption linesOpt("lines", "Number of lines in the generated drawing.", "N", QString::number(spec.lines));
+    QCommandLineOption insertsOpt("inserts", "Number of block inserts in the generated drawing.", "N", QString::number(spec.inserts));
+    QCommandLineOption blockOpt("block-entities", "Number of entities in the inserted block.", "N", QString::number(spec.blockEntities));
+    QCommandLineOption hatchesOpt("hatches", "Number of hatches in the generated drawing.", "N", QString::number(spec.hatches));
+    QCommandLineOption textsOpt("texts", "Number of texts in the generated drawing.", "N", QString::number(spec.texts));
+    QCommandLineOption splinesOpt("splines", "Number of splines in the generated drawing.", "N", QString::number(spec.splines));
+    QCommandLineOption arcsOpt("arcs", "Number of circles and arcs (each) in the generated drawing.", "N", QString::number(spec.arcs));
+    QCommandLineOption noSyntheticOpt("no-synthetic", "Benchmark only the given DXF files.");
+    QCommandLineOption iterationsOpt(QStringList() << "n" << "iterations", "Samples per operation.", "N", QString::number(options.iterations));
+    QCommandLineOption queriesOpt("queries", "Snap queries per sample.", "N", QString::number(options.queries));
+    QCommandLineOption resolutionOpt(QStringList() << "r" << "resolution", "Render size (Width x Height) in pixels.", "WxH");
+    QCommandLineOption outFileOpt(QStringList() << "o" << "outfile", "Output JSON file, standard output if omitted.", "file");
+
+    parser.addOptions({linesOpt, insertsOpt, blockOpt, hatchesOpt, textsOpt, splinesOpt, arcsOpt, noSyntheticOpt,
+                       iterationsOpt, queriesOpt, resolutionOpt, outFileOpt});
+    parser.addPositionalArgument("<dxf_files>", "Input DXF files");
+
+    parser.process(app);
+
+    spec.lines = intOption(parser, linesOpt, spec.lines);
+    spec.inserts = intOption(parser, insertsOpt, spec.inserts);
+    spec.blockEntities = intOption(parser, blockOpt, spec.blockEntities);
+    spec.hatches = intOption(parser, hatchesOpt, spec.hatches);
+    spec.texts = intOption(parser, textsOpt, spec.texts);
+    spec.splines = intOption(parser, splinesOpt, spec.splines);
+    spec.arcs = intOption(parser, arcsOpt, spec.arcs);
+    options.iterations = std::max(1, intOption(parser, iterationsOpt, options.iterations));
+    options.queries = intOption(parser, queriesOpt, options.queries);
+    options.resolution = parseResolution(parser.value(resolutionOpt), options.resolution);
+
+    QStringList dxfFiles;
+    for (const QString& arg: parser.positionalArguments()) {
+        if (QFileInfo(arg).suffix().toLower() == "dxf") {
+            dxfFiles.append(arg);
+        }
+    }
+    bool synthetic = !parser.isSet(noSyntheticOpt);
+    if (!synthetic && dxfFiles.isEmpty()) {
+        parser.showHelp(EXIT_FAILURE);
+    }
+
+    RS_FONTLIST->init();
+    RS_PATTERNLIST->init();
+
+    QTemporaryDir scratchDir;
+    if (!scratchDir.isValid()) {
+        qDebug() << "ERROR: Failed to create a temporary directory";
+        return 1;
+    }
+
+    QJsonArray drawings;
+    if (synthetic) {
+        auto graphic = std::make_unique<RS_Graphic>();
+        graphic->newDoc();
+        double generateMs = measureMs([&graphic, &spec]{
+            generateDrawing(graphic.get(), spec);
+        });
+        QJsonObject drawing = describeDrawing("synthetic", graphic.get());
+        QJsonObject results = benchmarkDrawing(graphic.get(), QString(),
+                                               scratchDir.filePath("synthetic.dxf"), options);
+        results["generate"] = summarize({generateMs});
+        drawing["results"] = results;
+        drawings.append(drawing);
+    }
+
+    for (int i = 0; i < dxfFiles.size(); i++) {
+        const QString& dxfFile = dxfFiles[i];
+        std::unique_ptr<RS_Graphic> graphic = readDxf(dxfFile, nullptr);
+        if (graphic == nullptr) {
+            qDebug() << "ERROR: Failed to open document" << dxfFile;
+            continue;
+        }
+        QJsonObject drawing = describeDrawing(dxfFile, graphic.get());
+        drawing["results"] = benchmarkDrawing(graphic.get(), dxfFile,
+                                              scratchDir.filePath(QString("drawing%1.dxf").arg(i)), options);
+        drawings.append(drawing);
+    }
+
+    QJsonObject report;
+    report["version"] = XSTR(LC_VERSION);
+    report["iterations"] = options.iterations;
+    report["queries"] = options.queries;
+    report["resolution"] = QString("%1x%2").arg(options.resolution.width()).arg(options.resolution.height());
+    report["drawings"] = drawings;
+    QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    QString outFile = parser.value(outFileOpt);
+    if (outFile.isEmpty()) {
+        QTextStream(stdout) << json;
+        return 0;
+    }
+    QFile file(outFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "ERROR: Failed to write" << outFile;
+        return 1;
+    }
+    file.write(json);
+    return 0;
+}
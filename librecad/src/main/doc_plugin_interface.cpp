@@ -821,6 +821,39 @@ void Doc_plugin_interface::addPoint(QPointF *start){
 		RS_DEBUG->print("Doc_plugin_interface::addPoint: currentContainer is nullptr");
 }
 
+void Doc_plugin_interface::addPoints(std::vector<QPointF> const& points){
+    if (doc) {
+        LC_UndoSection undo(doc, gView->getViewPort());
+        for (const QPointF& point: points) {
+            auto* entity = new RS_Point(doc, RS_PointData(RS_Vector(point.x(), point.y())));
+            doc->addEntity(entity);
+            undo.addUndoable(entity);
+        }
+    } else
+		RS_DEBUG->print("Doc_plugin_interface::addPoints: currentContainer is nullptr");
+}
+
+void Doc_plugin_interface::startUndoCycle(){
+    if (doc) {
+        doc->startUndoCycle();
+    }
+}
+
+void Doc_plugin_interface::endUndoCycle(){
+    if (doc) {
+        doc->endUndoCycle();
+    }
+}
+
+void Doc_plugin_interface::commandMessage(const QString& message){
+    m_actionContext->commandMessage(message);
+}
+
+bool Doc_plugin_interface::evalBatch(const QString& expr, const QString& variable, std::vector<double> const& values,
+                                     std::vector<double>& results){
+    return RS_Math::evalBatch(expr, variable, values, results);
+}
+
 void Doc_plugin_interface::addLine(QPointF *start, QPointF *end){
 
     RS_Vector v1(start->x(), start->y());
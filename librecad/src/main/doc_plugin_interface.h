@@ -128,6 +128,12 @@ public:
     bool getReal(qreal *num, const QString& message, const QString& title) override;
     bool getString(QString *txt, const QString& message, const QString& title) override;
     QString realToStr(const qreal num, const int units = 0, const int prec = 0) override;
+    void addPoints(std::vector<QPointF> const& points) override;
+    void startUndoCycle() override;
+    void endUndoCycle() override;
+    void commandMessage(const QString& message) override;
+    bool evalBatch(const QString& expr, const QString& variable, std::vector<double> const& values,
+                   std::vector<double>& results) override;
 
     //method to handle undo in Plugin_Entity 
     bool addToUndo(RS_Entity* current, RS_Entity* modified, DPI::Disposition how);
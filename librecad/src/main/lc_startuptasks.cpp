@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#include "lc_startuptasks.h"
+
+#include <algorithm>
+
+#include <QDebug>
+#include <QThreadPool>
+
+#include "rs_debug.h"
+
+LC_StartupTasks::LC_StartupTasks(bool profile)
+    : m_profile{profile}
+    , m_pool{std::make_unique<QThreadPool>()}{
+    m_timer.start();
+}
+
+LC_StartupTasks::~LC_StartupTasks() = default;
+
+/**
+ * Adds the task. Tasks are started by run(), in the order of adding as soon as all their dependencies are finished.
+ */
+void LC_StartupTasks::add(const QString& name, std::function<void()> task, const QStringList& dependencies,
+                          TaskThread thread) {
+    m_tasks.push_back({name, std::move(task), dependencies, thread});
+}
+
+bool LC_StartupTasks::isReady(const Task& task) const {
+    return std::all_of(task.dependencies.cbegin(), task.dependencies.cend(), [this](const QString& dependency) {
+        return std::any_of(m_tasks.cbegin(), m_tasks.cend(), [&dependency](const Task& other) {
+            return other.finished && other.name == dependency;
+        });
+    });
+}
+
+void LC_StartupTasks::execute(Task& task) {
+    qint64 startNs = elapsedNs();
+    task.function();
+    addPhase(task.name, startNs, task.thread);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    task.finished = true;
+    m_finishedCondition.notify_all();
+}
+
+/**
+ * Runs all added tasks and returns when they are finished. Main tasks are executed by the calling thread.
+ */
+void LC_StartupTasks::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (std::any_of(m_tasks.cbegin(), m_tasks.cend(), [](const Task& task) {return !task.finished;})) {
+        Task* mainTask = nullptr;
+        for (Task& task: m_tasks) {
+            if (task.started || !isReady(task)) {
+                continue;
+            }
+            if (task.thread == PoolThread) {
+                task.started = true;
+                m_pool->start([this, &task]() {execute(task);});
+            }
+            else if (mainTask == nullptr) {
+                mainTask = &task;
+            }
+        }
+
+        if (mainTask != nullptr) {
+            mainTask->started = true;
+            lock.unlock();
+            execute(*mainTask);
+            lock.lock();
+        }
+        else if (std::any_of(m_tasks.cbegin(), m_tasks.cend(), [](const Task& task) {return task.started && !task.finished;})) {
+            m_finishedCondition.wait(lock);
+        }
+        else {
+            // nothing is running and nothing may start: unknown dependency or a dependency cycle
+            for (Task& task: m_tasks) {
+                if (!task.started) {
+                    LC_ERR << "LC_StartupTasks::run(): unresolved dependencies of startup task " << task.name;
+                    task.dependencies.clear();
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Records wall time of the startup phase, from startNs to now.
+ */
+void LC_StartupTasks::addPhase(const QString& name, qint64 startNs, TaskThread thread) {
+    if (!m_profile) {
+        return;
+    }
+    qint64 durationNs = elapsedNs() - startNs;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_phases.push_back({name, thread, startNs, durationNs});
+}
+
+void LC_StartupTasks::report() const {
+    if (!m_profile) {
+        return;
+    }
+    std::vector<Phase> phases;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        phases = m_phases;
+    }
+    std::stable_sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) {
+        return a.startNs < b.startNs;
+    });
+
+    qDebug().noquote() << "Startup profile (wall time):";
+    qDebug().noquote() << QString("  %1 %2 %3 %4").arg("phase", -24).arg("thread", -6).arg("start ms", 10).arg("time ms", 10);
+    for (const Phase& phase: phases) {
+        qDebug().noquote() << QString("  %1 %2 %3 %4")
+                              .arg(phase.name, -24)
+                              .arg(phase.thread == PoolThread ? "pool" : "main", -6)
+                              .arg(phase.startNs * 1e-6, 10, 'f', 1)
+                              .arg(phase.durationNs * 1e-6, 10, 'f', 1);
+    }
+    qDebug().noquote() << QString("  %1 %2 %3").arg("total", -24).arg("", -6).arg(elapsedNs() * 1e-6, 21, 'f', 1);
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#ifndef LC_STARTUPTASKS_H
+#define LC_STARTUPTASKS_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+
+class QThreadPool;
+
+/**
+ * Runs initialization tasks of the application startup. Each task names tasks it depends on and is started as soon
+ * as they are finished. Pool tasks run concurrently on a thread pool, so they must not touch settings or widgets.
+ * Main tasks run on the calling (GUI) thread while pool tasks are in progress.
+ *
+ * Optionally measures wall time of the tasks and of other startup phases, and reports them on demand.
+ */
+class LC_StartupTasks {
+public:
+    enum TaskThread {
+        MainThread,
+        PoolThread
+    };
+
+    explicit LC_StartupTasks(bool profile);
+    ~LC_StartupTasks();
+
+    void add(const QString& name, std::function<void()> task, const QStringList& dependencies = {},
+             TaskThread thread = MainThread);
+    void run();
+
+    /** @return time since the startup began, to be passed to addPhase() later. */
+    qint64 elapsedNs() const {return m_timer.nsecsElapsed();}
+    void addPhase(const QString& name, qint64 startNs, TaskThread thread = MainThread);
+    void report() const;
+
+private:
+    struct Task {
+        QString name;
+        std::function<void()> function;
+        QStringList dependencies;
+        TaskThread thread = MainThread;
+        bool started = false;
+        bool finished = false;
+    };
+
+    struct Phase {
+        QString name;
+        TaskThread thread = MainThread;
+        qint64 startNs = 0;
+        qint64 durationNs = 0;
+    };
+
+    bool isReady(const Task& task) const;
+    void execute(Task& task);
+
+    bool m_profile = false;
+    QElapsedTimer m_timer;
+    std::vector<Task> m_tasks;
+    std::vector<Phase> m_phases;
+    std::unique_ptr<QThreadPool> m_pool;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_finishedCondition;
+};
+
+#endif // LC_STARTUPTASKS_H
@@ -27,6 +27,7 @@
 **
 **********************************************************************/
 #include <clocale>
+#include <memory>
 
 #include <QApplication>
 #include <QByteArray>
@@ -38,6 +39,7 @@
 #include <QSettings>
 #include <QSplashScreen>
 
+#include "console_benchmark.h"
 #include "console_dxf2pdf.h"
 #include "console_dxf2png.h"
 #include "lc_application.h"
@@ -46,6 +48,9 @@
 #include <QDir>
 
 #include "lc_iconcolorsoptions.h"
+#include "lc_plugininvoker.h"
+#include "lc_profiler.h"
+#include "lc_startuptasks.h"
 #include "qc_applicationwindow.h"
 #include "qg_dlginitial.h"
 #include "rs_debug.h"
@@ -59,6 +64,10 @@ namespace
 {
 // update splash for alpha/beta names)
     void updateSplash(const std::unique_ptr<QSplashScreen>& splash);
+
+// files for profiling data, written on exit if profiling is enabled by command line
+    QString g_profileStatisticsFile;
+    QString g_profileTraceFile;
 }
 
 void showFirstLoadSetupDialog(bool first_load) {
@@ -84,6 +93,7 @@ int showHelpMessage() {
     qDebug()<<"";
     qDebug()<<"Commands:";
     qDebug()<<"";
+    qDebug()<<"  benchmark\tTime loading, rendering, snapping and modification. Use -h for help.";
     qDebug()<<"  dxf2pdf\tRun librecad as console dxf2pdf tool. Use -h for help.";
     qDebug()<<"  dxf2png\tRun librecad as console dxf2png tool. Use -h for help.";
     qDebug()<<"  dxf2svg\tRun librecad as console dxf2svg tool. Use -h for help.";
@@ -92,6 +102,9 @@ int showHelpMessage() {
     qDebug()<<"";
     qDebug()<<"  -h, --help\tdisplay this message";
     qDebug()<<"  -d, --debug <level>";
+    qDebug()<<"  --profile <file>\tcollect rendering and interaction statistics, save them as JSON on exit";
+    qDebug()<<"  --profile-trace <file>\tcollect rendering and interaction trace, save it in Chrome trace format on exit";
+    qDebug()<<"  --startup-profile\treport wall time of each startup phase";
     qDebug()<<"";
     RS_DEBUG->print( RS_Debug::D_NOTHING, "possible debug levels:");
     RS_DEBUG->print( RS_Debug::D_NOTHING, "    %d Nothing", RS_Debug::D_NOTHING);
@@ -115,15 +128,15 @@ void showDebugSetupHelpMessage() {
     RS_DEBUG->print(RS_Debug::D_NOTHING, "    %d Debugging", RS_Debug::D_DEBUGGING);
 }
 
-void initFontList() {
+void initFontList(const QStringList& fontFiles) {
     RS_DEBUG->print("main: init fontlist..");
-    RS_FONTLIST->init();
+    RS_FONTLIST->init(fontFiles);
     RS_DEBUG->print("main: init fontlist: OK");
 }
 
-void initPatternList() {
+void initPatternList(const QStringList& patternFiles) {
     RS_DEBUG->print("main: init patternlist..");
-    RS_PATTERNLIST->init();
+    RS_PATTERNLIST->init(patternFiles);
     RS_DEBUG->print("main: init patternlist: OK");
 }
 
@@ -139,6 +152,41 @@ void loadTranslations() {
     RS_DEBUG->print("main: loading translation: OK");
 }
 
+/**
+ * Adds startup tasks that initialize fonts, patterns, translations and plugin libraries. Directories are resolved
+ * on the GUI thread, as they depend on settings, while scanning of directories and loading of plugin libraries
+ * run on the pool.
+ */
+void addInitTasks(LC_StartupTasks& startup) {
+    struct Paths {
+        QStringList fontDirs;
+        QStringList patternDirs;
+        QStringList pluginDirs;
+        QStringList fontFiles;
+        QStringList patternFiles;
+    };
+    auto paths = std::make_shared<Paths>();
+
+    startup.add("paths", [paths]() {
+        paths->fontDirs = RS_SYSTEM->getDirectoryList("fonts");
+        paths->patternDirs = RS_SYSTEM->getDirectoryList("patterns");
+        paths->pluginDirs = RS_SYSTEM->getDirectoryList("plugins");
+    });
+    startup.add("scan fonts", [paths]() {
+        paths->fontFiles = RS_System::getFileList(paths->fontDirs, "lff");
+        paths->fontFiles.append(RS_System::getFileList(paths->fontDirs, "cxf"));
+    }, {"paths"}, LC_StartupTasks::PoolThread);
+    startup.add("scan patterns", [paths]() {
+        paths->patternFiles = RS_System::getFileList(paths->patternDirs, "dxf");
+    }, {"paths"}, LC_StartupTasks::PoolThread);
+    startup.add("preload plugins", [paths]() {
+        LC_PluginInvoker::preloadPlugins(paths->pluginDirs);
+    }, {"paths"}, LC_StartupTasks::PoolThread);
+    startup.add("translations", loadTranslations);
+    startup.add("font list", [paths]() {initFontList(paths->fontFiles);}, {"scan fonts"});
+    startup.add("pattern list", [paths]() {initPatternList(paths->patternFiles);}, {"scan patterns"});
+}
+
 void initSystem(char** argv, LC_Application& app) {
     RS_DEBUG->print("param 0: %s", argv[0]);
 
@@ -176,6 +224,13 @@ int execApplication(LC_Application& app) {
 
     RS_DEBUG->print("main: exited Qt event loop");
 
+    if (!g_profileStatisticsFile.isEmpty()) {
+        LC_PROFILER->exportJson(g_profileStatisticsFile);
+    }
+    if (!g_profileTraceFile.isEmpty()) {
+        LC_PROFILER->exportChromeTrace(g_profileTraceFile);
+    }
+
     // Destroy the singleton
     QC_ApplicationWindow::getAppWindow().reset();
     return return_code;
@@ -252,6 +307,9 @@ int main(int argc, char** argv) {
         if (arg.compare("dxf2png") == 0 || arg == "dxf2svg") {
             return console_dxf2png(argc, argv);
         }
+        if (arg.compare("benchmark") == 0) {
+            return console_benchmark(argc, argv);
+        }
     }
 
     RS_DEBUG->setLevel(RS_Debug::D_WARNING);
@@ -271,6 +329,7 @@ int main(int argc, char** argv) {
 
 
     bool allowOptions=true;
+    bool startupProfile = false;
     QList<int> argClean;
     for (int i=0; i<argc; i++)
     {
@@ -285,6 +344,27 @@ int main(int argc, char** argv) {
                              help1.compare(argstr, Qt::CaseInsensitive)==0 )) {
             return showHelpMessage();
         }
+        if (allowOptions && (argstr == "--profile" || argstr == "--profile-trace")) {
+            argClean<<i;
+            if (i + 1 < argc) {
+                ++i;
+                argClean<<i;
+                QString fileName = QFile::decodeName(argv[i]);
+                if (argstr == "--profile") {
+                    g_profileStatisticsFile = fileName;
+                }
+                else {
+                    g_profileTraceFile = fileName;
+                }
+                LC_PROFILER->setEnabled(true);
+            }
+            continue;
+        }
+        if (allowOptions && argstr == "--startup-profile") {
+            argClean<<i;
+            startupProfile = true;
+            continue;
+        }
         const QString lpDebugSwitch0("-d"),lpDebugSwitch1("--debug") ;
 
         if (allowOptions&& (argstr.startsWith(lpDebugSwitch0, Qt::CaseInsensitive) ||
@@ -322,7 +402,10 @@ int main(int argc, char** argv) {
             }
         }
     }
+    LC_StartupTasks startup(startupProfile);
+    qint64 phaseStart = startup.elapsedNs();
     initSystem(argv, app);
+    startup.addPhase("system", phaseStart);
     showFirstLoadSetupDialog(first_load);
 
     std::unique_ptr<QSplashScreen> splash;
@@ -335,10 +418,10 @@ int main(int argc, char** argv) {
         RS_DEBUG->print("main: splashscreen: OK");
     }
 
-    initFontList();
-    initPatternList();
-    loadTranslations();
+    addInitTasks(startup);
+    startup.run();
 
+    phaseStart = startup.elapsedNs();
     RS_DEBUG->print("main: creating main window..");
     QC_ApplicationWindow& appWin = *QC_ApplicationWindow::getAppWindow();
     auto& appWindow = QC_ApplicationWindow::getAppWindow();
@@ -378,6 +461,7 @@ int main(int argc, char** argv) {
     RS_DEBUG->print("main: set focus");
     appWin.setFocus();
     RS_DEBUG->print("main: creating main window: OK");
+    startup.addPhase("main window", phaseStart);
 
     if (splash != nullptr){
         RS_DEBUG->print("main: updating splash");
@@ -393,7 +477,9 @@ int main(int argc, char** argv) {
 
     // parse command line arguments that might not need a launched program:
     QStringList fileList = handleArgs(argc, argv, argClean);
+    phaseStart = startup.elapsedNs();
     loadFilesOnStartup(splash.get(), appWin, app, fileList);
+    startup.addPhase("load files", phaseStart);
 
     appWin.initCompleted();
 
@@ -416,6 +502,7 @@ int main(int argc, char** argv) {
     }
     LC_GROUP_END();
 
+    startup.report();
     return execApplication(app);
 }
 
@@ -526,6 +526,39 @@ public:
     * \return a string with the converted number.
     */
     virtual QString realToStr(const qreal num, const int units = 0, const int prec = 0) = 0;
+
+    //! Add point entities to current document.
+    /*! Add point entities to current document with current attributes, all of them in a single undo cycle.
+    * Much faster than adding points one by one for large imports.
+    *  \param points points coordinates.
+    */
+    virtual void addPoints(std::vector<QPointF> const& points) = 0;
+
+    //! Start an undo cycle.
+    /*! Entities added until the matching endUndoCycle() are undone and redone all at once.
+    * Cycles may be nested, only the outermost one is recorded.
+    */
+    virtual void startUndoCycle() = 0;
+
+    //! End the undo cycle started by startUndoCycle().
+    virtual void endUndoCycle() = 0;
+
+    //! Show a message in the command widget.
+    /*! \param message the message to show.
+    */
+    virtual void commandMessage(const QString& message) = 0;
+
+    //! Evaluate a math expression for many values of its variable.
+    /*! The expression is compiled once and cached by the application, as for the command line input,
+    * so "pi" may be used. Unlike the other methods, this one may be called from worker threads.
+    * \param expr expression to evaluate.
+    * \param variable name of the variable in the expression.
+    * \param values values of the variable.
+    * \param results results in the order of values.
+    * \return false if the expression is invalid.
+    */
+    virtual bool evalBatch(const QString& expr, const QString& variable, std::vector<double> const& values,
+                           std::vector<double>& results) = 0;
 };
 
 
@@ -43,6 +43,39 @@ LC_PluginInvoker::LC_PluginInvoker(QC_ApplicationWindow *appWindow, LC_ActionCon
 
 LC_PluginInvoker::~LC_PluginInvoker() = default;
 
+bool LC_PluginInvoker::isPluginFile([[maybe_unused]] const QString& fileName) {
+#ifdef Q_OS_MAC
+    if (!fileName.contains(".dylib"))
+        return false;
+#endif
+#if (defined (_WIN32) || defined (_WIN32) || defined (_WIN64))
+    if (!fileName.contains(".dll"))
+        return false;
+#endif
+    return true;
+}
+
+/**
+ * Loads plugin libraries without instantiating the plugins, so it may run on a worker thread while the
+ * application starts. Libraries stay loaded, and loadPlugins() creates plugin instances on the GUI thread
+ * without loading and resolving them again. Errors are reported by loadPlugins().
+ */
+void LC_PluginInvoker::preloadPlugins(const QStringList& pluginDirs){
+    QStringList preloadedFileNames;
+    for (const QString& dirName: pluginDirs) {
+        QDir pluginsDir(dirName);
+        for (const QString &fileName: pluginsDir.entryList(QDir::Files)) {
+            if (!isPluginFile(fileName) || preloadedFileNames.contains(fileName)) {
+                continue;
+            }
+            QPluginLoader pluginLoader(pluginsDir.absoluteFilePath(fileName));
+            if (pluginLoader.load()) {
+                preloadedFileNames.push_back(fileName);
+            }
+        }
+    }
+}
+
 void LC_PluginInvoker::loadPlugins(){
     m_loadedPluginList.clear();
     QStringList lst = RS_SYSTEM->getDirectoryList("plugins");
@@ -52,17 +85,11 @@ void LC_PluginInvoker::loadPlugins(){
     for (int i = 0; i < lst.size(); ++i) {
         QDir pluginsDir(lst.at(i));
         for (const QString &fileName: pluginsDir.entryList(QDir::Files)) {
+            if (!isPluginFile(fileName)) {
+                continue;
+            }
             // Skip loading a plugin if a plugin with the same
             // filename has already been loaded.
-#ifdef Q_OS_MAC
-            if (!fileName.contains(".dylib"))
-                continue;
-#endif
-#if (defined (_WIN32) || defined (_WIN32) || defined (_WIN64))
-            if (!fileName.contains(".dll"))
-                continue;
-#endif
-
             if (loadedPluginFileNames.contains(fileName)) {
                 continue;
             }
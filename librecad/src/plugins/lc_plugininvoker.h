@@ -23,6 +23,7 @@
 #define LC_PLUGININVOKER_H
 
 #include <QObject>
+#include <QStringList>
 
 #include "lc_actioncontext.h"
 
@@ -36,9 +37,11 @@ public:
     explicit LC_PluginInvoker(QC_ApplicationWindow* appWindow, LC_ActionContext* ctx);
     ~LC_PluginInvoker() override;
     void loadPlugins();
+    static void preloadPlugins(const QStringList& pluginDirs);
 public slots:
     void execPlug();
 private:
+    static bool isPluginFile(const QString& fileName);
     QC_ApplicationWindow* m_appWindow = nullptr;
     QList<QC_PluginInterface*> m_loadedPluginList;
     LC_ActionContext* m_actionContext = nullptr;
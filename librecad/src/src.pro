@@ -328,6 +328,7 @@ HEADERS += \
     lib/actions/rs_previewactioninterface.h \
     lib/actions/rs_snapper.h \
     lib/creation/rs_creation.h \
+    lib/debug/lc_profiler.h \
     lib/debug/rs_debug.h \
     lib/engine/document/ucs/lc_ucs.h \
     lib/engine/document/views/lc_view.h \
@@ -335,6 +336,7 @@ HEADERS += \
     lib/engine/document/entities/lc_cachedlengthentity.h \
     lib/engine/overlays/crosshair/lc_crosshair.h \
     lib/engine/document/container/lc_looputils.h \
+    lib/engine/document/container/lc_selectionset.h \
     lib/engine/document/entities/lc_parabola.h \
     lib/engine/overlays/references/lc_refarc.h \
     lib/engine/overlays/references/lc_refcircle.h \
@@ -384,6 +386,7 @@ HEADERS += \
     lib/engine/document/entities/rs_mtext.h \
     lib/engine/document/dimstyles/lc_dimstyle.h \
     lib/engine/document/dimstyles/lc_dimstyleslist.h \
+    lib/engine/document/dimstyles/lc_resolveddimstyle.h \
     lib/engine/overlays/rs_overlayline.h \
     lib/engine/overlays/overlay_box/rs_overlaybox.h \
     lib/engine/document/patterns/rs_pattern.h \
@@ -422,6 +425,7 @@ HEADERS += \
     lib/gui/lc_graphicviewport.h \
     lib/gui/lc_graphicviewportlistener.h \
     lib/gui/render/headless/lc_printviewportrenderer.h \
+    lib/gui/render/lc_arctessellationcache.h \
     lib/gui/render/lc_graphicviewportrenderer.h \
     plugins/lc_plugininvoker.h \
     lib/actions/lc_actioncontext.h \
@@ -445,10 +449,13 @@ HEADERS += \
     ui/main/support/lc_appwindowdialogsinvoker.h \
     ui/main/lc_appwindowaware.h \
     ui/main/lc_defaultactioncontext.h \
+    ui/main/persistence/lc_documentsloader.h \
     ui/main/persistence/lc_documentsstorage.h \
     lib/gui/render/widget/lc_graphicviewrenderer.cpp \
     lib/gui/render/widget/lc_printpreviewviewrenderer.cpp \
     lib/gui/render/widget/lc_widgetviewportrenderer.cpp \
+    lib/gui/render/widget/lc_drawingtilecache.h \
+    lib/gui/render/widget/lc_layerrendercache.h \
     lib/modification/lc_align.h \
     ui/action_options/curve/lc_actiondrawarc2poptions.h \
     ui/action_options/misc/lc_midlineoptions.h \
@@ -513,16 +520,20 @@ HEADERS += \
     lib/modification/rs_selection.h \
     lib/math/rs_math.h \
     lib/math/lc_quadratic.h \
+    main/console_benchmark.h \
     main/console_dxf2png.h \
     test/lc_simpletests.h \
     lib/generators/makercamsvg/lc_makercamsvg.h \
     lib/generators/makercamsvg/lc_xmlwriterinterface.h \
     lib/generators/makercamsvg/lc_xmlwriterqxmlstreamwriter.h \
+    lib/generators/makercamsvg/lc_xmlwriterstream.h \
     lib/engine/document/entities/lc_rect.h \
+    lib/engine/utils/lc_imagecache.h \
     lib/engine/utils/lc_rtree.h \
     lib/engine/undo/lc_undosection.h \
     lib/printing/lc_printing.h \
     main/lc_application.h \
+    main/lc_startuptasks.h \
     ui/action_options/curve/lc_ellipsearcoptions.h \
     ui/action_options/ellipse/lc_ellipse1pointoptions.h \
     ui/components/status_bar/lc_relzerocoordinateswidget.h \
@@ -603,11 +614,15 @@ SOURCES += \
     ui/main/support/lc_appwindowdialogsinvoker.cpp \
     ui/main/lc_appwindowaware.cpp \
     ui/main/lc_defaultactioncontext.cpp \
+    ui/main/persistence/lc_documentsloader.cpp \
     ui/main/persistence/lc_documentsstorage.cpp \
+    lib/gui/render/lc_arctessellationcache.cpp \
     lib/gui/render/lc_graphicviewportrenderer.cpp \
     lib/gui/render/widget/lc_graphicviewrenderer.cpp \
     lib/gui/render/widget/lc_printpreviewviewrenderer.cpp \
     lib/gui/render/widget/lc_widgetviewportrenderer.cpp \
+    lib/gui/render/widget/lc_drawingtilecache.cpp \
+    lib/gui/render/widget/lc_layerrendercache.cpp \
     lib/modification/lc_align.cpp \
     ui/action_options/curve/lc_actiondrawarc2poptions.cpp \
     ui/action_options/misc/lc_midlineoptions.cpp \
@@ -631,6 +646,7 @@ SOURCES += \
     lib/actions/rs_previewactioninterface.cpp \
     lib/actions/rs_snapper.cpp \
     lib/creation/rs_creation.cpp \
+    lib/debug/lc_profiler.cpp \
     lib/debug/rs_debug.cpp \
     lib/engine/document/ucs/lc_ucs.cpp \
     lib/engine/document/views/lc_view.cpp \
@@ -638,6 +654,7 @@ SOURCES += \
     lib/engine/document/entities/lc_cachedlengthentity.cpp \
     lib/engine/overlays/crosshair/lc_crosshair.cpp \
     lib/engine/document/container/lc_looputils.cpp \
+    lib/engine/document/container/lc_selectionset.cpp \
     lib/engine/document/entities/lc_parabola.cpp \
     lib/engine/overlays/references/lc_refarc.cpp \
     lib/engine/overlays/references/lc_refcircle.cpp \
@@ -660,6 +677,7 @@ SOURCES += \
     lib/engine/document/entities/lc_dimarc.cpp \
     lib/engine/document/dimstyles/lc_dimstyle.cpp \
     lib/engine/document/dimstyles/lc_dimstyleslist.cpp \
+    lib/engine/document/dimstyles/lc_resolveddimstyle.cpp \
     lib/engine/document/rs_document.cpp \
     lib/engine/document/entities/rs_ellipse.cpp \
     lib/engine/document/entities/rs_entity.cpp \
@@ -754,19 +772,23 @@ SOURCES += \
     lib/modification/rs_selection.cpp \
     lib/engine/rs_color.cpp \
     lib/engine/rs_pen.cpp \
+    main/console_benchmark.cpp \
     main/console_dxf2png.cpp \
     test/lc_simpletests.cpp \
     lib/generators/makercamsvg/lc_xmlwriterqxmlstreamwriter.cpp \
+    lib/generators/makercamsvg/lc_xmlwriterstream.cpp \
     lib/generators/makercamsvg/lc_makercamsvg.cpp \
     lib/engine/document/entities/rs_atomicentity.cpp \
     lib/engine/undo/rs_undocycle.cpp \
     lib/engine/rs_flags.cpp \
     lib/engine/document/entities/lc_rect.cpp \
+    lib/engine/utils/lc_imagecache.cpp \
     lib/engine/utils/lc_rtree.cpp \
     lib/engine/undo/lc_undosection.cpp \
     lib/engine/rs.cpp \
     lib/printing/lc_printing.cpp \
     main/lc_application.cpp \
+    main/lc_startuptasks.cpp \
     ui/action_options/curve/lc_ellipsearcoptions.cpp \
     ui/action_options/ellipse/lc_ellipse1pointoptions.cpp \
     ui/components/status_bar/lc_relzerocoordinateswidget.cpp \
@@ -71,7 +71,7 @@ void QG_PatternBox::setPattern(const QString& pName) {
     slotPatternChanged(currentIndex());
 }
 
-std::shared_ptr<RS_Pattern> QG_PatternBox::getPattern() {
+std::shared_ptr<const RS_Pattern> QG_PatternBox::getPattern() {
 	if (m_currentPattern == nullptr || m_currentPattern->countDeep()==0) {
 		m_currentPattern = RS_PATTERNLIST->requestPattern(currentText());
 	}
@@ -39,7 +39,7 @@ class QG_PatternBox: public QComboBox {
 public:
     QG_PatternBox(QWidget* parent=nullptr);
     ~QG_PatternBox() override;
-    std::shared_ptr<RS_Pattern> getPattern();
+    std::shared_ptr<const RS_Pattern> getPattern();
     void setPattern(const QString& pName);
     void init();
 private slots:
@@ -47,7 +47,7 @@ private slots:
 signals:
 	void patternChanged();
 private:
-    std::shared_ptr<RS_Pattern> m_currentPattern;
+    std::shared_ptr<const RS_Pattern> m_currentPattern;
 };
 
 #endif
@@ -171,7 +171,6 @@ void QG_DlgHatch::updatePreview() {
     double angle = toWCSAngle(leAngle, 0.0);
     double prevSize = 100.0;
     if (m_pattern) {
-        m_pattern->calculateBorders();
         prevSize = std::max(prevSize, m_pattern->getSize().magnitude());
     }
 
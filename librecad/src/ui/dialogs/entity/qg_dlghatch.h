@@ -48,7 +48,7 @@ protected slots:
     void languageChange();
 protected:
     std::unique_ptr<RS_EntityContainer> m_preview;
-    std::shared_ptr<RS_Pattern> m_pattern;
+    std::shared_ptr<const RS_Pattern> m_pattern;
     RS_Hatch* m_entity = nullptr;
     bool m_isNew = false;
     void addRectangle(RS_Pen pen, const RS_Vector &v0, const RS_Vector &v1, RS_EntityContainer *container);
@@ -34,6 +34,7 @@
 #include "lc_actiongroup.h"
 #include "lc_actiongroupmanager.h"
 #include "lc_infocursorsettingsmanager.h"
+#include "lc_profiler.h"
 #include "qc_applicationwindow.h"
 #include "rs_settings.h"
 #include "lc_shortcutinfo.h"
@@ -568,6 +569,10 @@ void LC_ActionFactory::createOptionsActionsUncheckable(QMap<QString, QAction *>
         {"DeviceOptions", &QC_ApplicationWindow::showDeviceOptions, tr("Device Options")},
         {"ReloadStyleSheet", &QC_ApplicationWindow::reloadStyleSheet, tr("Reload Style Sheet")}
     });
+
+    createMainWindowActions(map, group, {
+        {"OptionsProfiler", &QC_ApplicationWindow::toggleProfiler, tr("Profile Rendering")}
+    }, true);
 }
 
 void LC_ActionFactory::createFileActions(QMap<QString, QAction *> &map, QActionGroup *group) {
@@ -678,6 +683,8 @@ void LC_ActionFactory::setupCreatedActions(QMap<QString, QAction *> &map) {
     map["RightDockAreaToggle"]->setChecked(true);
     bool statusBarVisible = LC_GET_ONE_BOOL("Appearance", "StatusBarVisible", false);
     map["ViewStatusBar"]->setChecked(statusBarVisible);
+    // profiler may be enabled from command line
+    map["OptionsProfiler"]->setChecked(LC_Profiler::isEnabled());
     map["OptionsGeneral"]->setMenuRole(QAction::NoRole);
 
     connect(m_appWin, &QC_ApplicationWindow::printPreviewChanged, map["FilePrint"], &QAction::setChecked);
@@ -289,6 +289,7 @@ void LC_MenuFactory::createSettingsMenu(QMenuBar *menu_bar, QList<QMenu *> &topM
                              "WidgetOptions",
                              "DeviceOptions",
                              "ReloadStyleSheet",
+                             "OptionsProfiler",
                              "",
                              "OptionsDrawing",
                          });
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_documentsloader.h"
+
+#include <QThread>
+#include <QThreadPool>
+
+#include "lc_imagecache.h"
+#include "rs_fileio.h"
+#include "rs_filterinterface.h"
+#include "rs_graphic.h"
+
+struct LC_DocumentsLoader::Task {
+    QString fileName;
+    RS2::FormatType type = RS2::FormatUnknown;
+    std::unique_ptr<RS_Graphic> graphic;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    bool loaded = false;
+    bool done = false;
+};
+
+LC_DocumentsLoader::LC_DocumentsLoader(QObject* parent)
+    :QObject(parent)
+    , m_pool{std::make_unique<QThreadPool>()}
+    , m_cancelled{std::make_shared<std::atomic<bool>>(false)}{
+}
+
+LC_DocumentsLoader::~LC_DocumentsLoader() {
+    // results queued for this object are dropped with it, and their graphics are deleted with tasks.
+    // Running imports check the flag for each entity, so waiting is short.
+    m_pool->clear();
+    m_cancelled->store(true);
+    m_pool->waitForDone();
+}
+
+bool LC_DocumentsLoader::canLoadInBackground(RS2::FormatType type) {
+    return type == RS2::FormatDXFRW || type == RS2::FormatJWW;
+}
+
+void LC_DocumentsLoader::load(const std::vector<std::pair<QString, RS2::FormatType>>& files) {
+    if (files.empty()) {
+        return;
+    }
+    if (m_cancelled->load()) {
+        // tasks cancelled before are still discarded
+        m_cancelled = std::make_shared<std::atomic<bool>>(false);
+    }
+    // create singletons before workers use them, the image cache reads its size from settings
+    RS_FileIO::instance();
+    LC_ImageCache::instance();
+    for (const auto& [fileName, type]: files) {
+        auto task = std::make_shared<Task>();
+        task->fileName = fileName;
+        task->type = type;
+        task->cancelled = m_cancelled;
+        // constructor and newDoc() read settings
+        task->graphic = std::make_unique<RS_Graphic>();
+        task->graphic->newDoc();
+        m_tasks.push_back(task);
+
+        m_pool->start([this, task]() {
+            if (!task->cancelled->load()) {
+                loadGraphic(*task);
+            }
+            QMetaObject::invokeMethod(this, [this, task]() {
+                task->done = true;
+                onTaskDone();
+            }, Qt::QueuedConnection);
+        });
+    }
+    emit progress(m_doneCount, static_cast<int>(m_tasks.size()));
+}
+
+void LC_DocumentsLoader::cancel() {
+    m_cancelled->store(true);
+}
+
+/**
+ * Runs on a worker thread. Does the same as LC_DocumentsStorage::loadGraphic(), but neither reads
+ * settings nor shows messages. The import stops once the task is cancelled.
+ */
+void LC_DocumentsLoader::loadGraphic(Task& task) {
+    std::unique_ptr<RS_FilterInterface> filter = RS_FileIO::instance()->getImportFilter(task.fileName, task.type);
+    if (filter == nullptr) {
+        return;
+    }
+    filter->setCancelFlag(task.cancelled);
+    task.loaded = filter->fileImport(*task.graphic, task.fileName, task.type);
+}
+
+/**
+ * Passes results of finished tasks in the order of files.
+ */
+void LC_DocumentsLoader::onTaskDone() {
+    m_doneCount++;
+    if (m_passingResults) {
+        // receivers may process events, the outer call passes this result too
+        return;
+    }
+    m_passingResults = true;
+    while (m_nextTask < m_tasks.size() && m_tasks[m_nextTask]->done) {
+        std::shared_ptr<Task> task = m_tasks[m_nextTask++];
+        if (task->cancelled->load()) {
+            task->graphic.reset();
+        }
+        else if (task->loaded) {
+            emit documentLoaded(task->graphic.release(), task->fileName);
+        }
+        else {
+            task->graphic.reset();
+            emit documentFailed(task->fileName, task->type);
+        }
+    }
+    m_passingResults = false;
+    emit progress(m_doneCount, static_cast<int>(m_tasks.size()));
+    if (m_nextTask == m_tasks.size()) {
+        m_tasks.clear();
+        m_nextTask = 0;
+        m_doneCount = 0;
+        emit finished();
+    }
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_DOCUMENTSLOADER_H
+#define LC_DOCUMENTSLOADER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QObject>
+
+#include "rs.h"
+
+class QThreadPool;
+class RS_Graphic;
+
+/**
+ * Loads several drawings at once. Each file is parsed and its graphic is built on a worker thread,
+ * finished graphics are passed in the order of files to documentLoaded() on the GUI thread, so they
+ * are attached to MDI windows there.
+ *
+ * Only DXF and JWW files are loaded this way, as other formats may ask the user during the import.
+ * Graphics are created and settings are read on the GUI thread before the loading starts, since
+ * RS_Settings is not thread-safe. That includes settings used by dimensions, which RS_Graphic keeps.
+ * A file that failed to load is passed to documentFailed(), so it could be opened in the usual way,
+ * which reports the error.
+ */
+class LC_DocumentsLoader: public QObject {
+    Q_OBJECT
+public:
+    explicit LC_DocumentsLoader(QObject* parent = nullptr);
+    ~LC_DocumentsLoader() override;
+
+    static bool canLoadInBackground(RS2::FormatType type);
+    /** Queues files for loading, type of each file is already detected. */
+    void load(const std::vector<std::pair<QString, RS2::FormatType>>& files);
+    /** Files not started yet are skipped, running imports stop, graphics not passed yet are discarded. */
+    void cancel();
+    bool isLoading() const {return !m_tasks.empty();}
+signals:
+    /** The receiver takes ownership of the graphic. */
+    void documentLoaded(RS_Graphic* graphic, const QString& fileName);
+    void documentFailed(const QString& fileName, RS2::FormatType type);
+    void progress(int loaded, int total);
+    void finished();
+protected:
+    struct Task;
+    static void loadGraphic(Task& task);
+    void onTaskDone();
+private:
+    std::unique_ptr<QThreadPool> m_pool;
+    std::vector<std::shared_ptr<Task>> m_tasks;
+    /** index of the first task, which result is not passed yet */
+    size_t m_nextTask = 0;
+    int m_doneCount = 0;
+    bool m_passingResults = false;
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+#endif // LC_DOCUMENTSLOADER_H
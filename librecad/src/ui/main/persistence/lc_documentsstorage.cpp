@@ -160,15 +160,22 @@ bool LC_DocumentsStorage::loadGraphic(RS_Graphic* graphic,  const QString &filen
     bool ret = RS_FileIO::instance()->fileImport(*graphic, filename, type);
 
     if (ret) {
-        QFileInfo finfo(filename);
-        auto autosaveFileName = createAutoSaveFileName(finfo);
-        graphic->setAutosaveFileName(autosaveFileName);
-        graphic->setFilename(filename);
-        graphic->markSaved(finfo.lastModified());
+        initLoadedGraphic(graphic, filename);
     }
     return ret;
 }
 
+/**
+ * Binds the graphic just loaded to its file.
+ */
+void LC_DocumentsStorage::initLoadedGraphic(RS_Graphic* graphic, const QString &filename) const {
+    QFileInfo finfo(filename);
+    auto autosaveFileName = createAutoSaveFileName(finfo);
+    graphic->setAutosaveFileName(autosaveFileName);
+    graphic->setFilename(filename);
+    graphic->markSaved(finfo.lastModified());
+}
+
 bool LC_DocumentsStorage::doSave(RS_Graphic* graphic, bool sameFile) {
     bool result = false;
     RS2::FormatType actualType = graphic->getFormatType();
@@ -31,9 +31,12 @@
 
 
 #include <QCloseEvent>
+#include <QDir>
+#include <QFileDialog>
 #include <QMdiArea>
 #include <QMessageBox>
 #include <QMimeData>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QStatusBar>
 #include <QTimer>
@@ -48,6 +51,7 @@
 #include "lc_creatorinvoker.h"
 #include "lc_customstylehelper.h"
 #include "lc_defaultactioncontext.h"
+#include "lc_documentsloader.h"
 #include "lc_exporttoimageservice.h"
 #include "lc_graphicviewport.h"
 #include "lc_gridviewinvoker.h"
@@ -60,6 +64,7 @@
 #include "lc_penwizard.h"
 #include "lc_printing.h"
 #include "lc_plugininvoker.h"
+#include "lc_profiler.h"
 #include "lc_qtstatusbarmanager.h"
 #include "lc_quickinfowidget.h"
 #include "lc_releasechecker.h"
@@ -90,6 +95,7 @@
 #include "rs_actionlibraryinsert.h"
 #include "rs_actionprintpreview.h"
 #include "rs_debug.h"
+#include "rs_fileio.h"
 #include "rs_settings.h"
 #include "rs_units.h"
 #include "twostackedlabels.h"
@@ -399,14 +405,15 @@ bool QC_ApplicationWindow::isAcceptableDragNDropFileName(const QString& fileName
 void QC_ApplicationWindow::dropEvent(QDropEvent *event) {
     event->acceptProposedAction();
     //limit maximum number of dropped files to be opened
-    unsigned counts = 0;
+    QStringList fileNames;
     for (QUrl const &url: event->mimeData()->urls()) {
         const QString &fileName = url.toLocalFile();
         if (isAcceptableDragNDropFileName(fileName)) {
-            openFile(fileName);
-            if (++counts > 32) return;
+            fileNames << fileName;
+            if (fileNames.size() > 32) break;
         }
     }
+    openFiles(fileNames);
 }
 
 void QC_ApplicationWindow::dragEnterEvent(QDragEnterEvent *event) {
@@ -996,6 +1003,12 @@ void QC_ApplicationWindow::openFile(const QString &fileName, RS2::FormatType typ
         return;
     }
 
+    finishFileOpening(w, fileName);
+
+    QApplication::restoreOverrideCursor();
+}
+
+void QC_ApplicationWindow::finishFileOpening(QC_MDIWindow* w, const QString& fileName) {
     // update recent files menu:
     m_recentFilesList->add(fileName);
     openedFiles.push_back(fileName);
@@ -1020,8 +1033,88 @@ void QC_ApplicationWindow::openFile(const QString &fileName, RS2::FormatType typ
 
     QString message = tr("Loaded document: ") + fileName;
     notificationMessage(message, 2000);
+}
 
-    QApplication::restoreOverrideCursor();
+/**
+ * Opens several files. If there are at least two DXF or JWW files, they are parsed concurrently in
+ * background and attached to windows as they are ready, while the rest is opened one by one.
+ * The window of fileToActivate, if any, is activated once all files are opened.
+ */
+void QC_ApplicationWindow::openFiles(const QStringList& fileNames, const QString& fileToActivate) {
+    std::vector<std::pair<QString, RS2::FormatType>> backgroundFiles;
+    QStringList foregroundFiles;
+    for (const QString& fileName: fileNames) {
+        RS2::FormatType type = RS_FileIO::detectFormat(fileName);
+        if (QFileInfo::exists(fileName) && LC_DocumentsLoader::canLoadInBackground(type)) {
+            backgroundFiles.emplace_back(fileName, type);
+        }
+        else {
+            foregroundFiles << fileName;
+        }
+    }
+
+    bool loading = m_documentsLoader != nullptr && m_documentsLoader->isLoading();
+    if (backgroundFiles.size() < 2 && !loading) {
+        // nothing to load concurrently
+        for (const QString& fileName: fileNames) {
+            openFile(fileName);
+        }
+        if (!fileToActivate.isEmpty()) {
+            activateWindowWithFile(fileToActivate);
+        }
+        return;
+    }
+
+    if (m_documentsLoader == nullptr) {
+        m_documentsLoader = new LC_DocumentsLoader(this);
+        connect(m_documentsLoader, &LC_DocumentsLoader::documentLoaded, this, &QC_ApplicationWindow::onBackgroundDocumentLoaded);
+        connect(m_documentsLoader, &LC_DocumentsLoader::documentFailed, this, [this](const QString& fileName, RS2::FormatType type){
+            // opened again in the usual way, which reports the error
+            openFile(fileName, type);
+        });
+        connect(m_documentsLoader, &LC_DocumentsLoader::progress, this, &QC_ApplicationWindow::onBackgroundLoadingProgress);
+        connect(m_documentsLoader, &LC_DocumentsLoader::finished, this, &QC_ApplicationWindow::onBackgroundLoadingFinished);
+    }
+    if (m_documentsLoadingProgress == nullptr) {
+        m_documentsLoadingProgress = new QProgressDialog(tr("Opening files..."), tr("Cancel"), 0, 0, this);
+        m_documentsLoadingProgress->setWindowModality(Qt::NonModal);
+        m_documentsLoadingProgress->setMinimumDuration(500);
+        connect(m_documentsLoadingProgress, &QProgressDialog::canceled, m_documentsLoader, &LC_DocumentsLoader::cancel);
+    }
+    m_fileToActivateAfterLoading = fileToActivate;
+    m_documentsLoader->load(backgroundFiles);
+
+    for (const QString& fileName: foregroundFiles) {
+        openFile(fileName);
+    }
+}
+
+void QC_ApplicationWindow::onBackgroundDocumentLoaded(RS_Graphic* graphic, const QString& fileName) {
+    if (openedFiles.indexOf(fileName) >= 0) {
+        QString message = tr("Warning: File already opened : ") + fileName;
+        notificationMessage(message, 2000);
+    }
+    auto w = createNewDrawingWindow(graphic, fileName);
+    w->adoptLoadedDocument(fileName);
+    finishFileOpening(w, fileName);
+}
+
+void QC_ApplicationWindow::onBackgroundLoadingProgress(int loaded, int total) {
+    if (m_documentsLoadingProgress != nullptr && !m_documentsLoadingProgress->wasCanceled()) {
+        m_documentsLoadingProgress->setMaximum(total);
+        m_documentsLoadingProgress->setValue(loaded);
+    }
+}
+
+void QC_ApplicationWindow::onBackgroundLoadingFinished() {
+    if (m_documentsLoadingProgress != nullptr) {
+        m_documentsLoadingProgress->deleteLater();
+        m_documentsLoadingProgress = nullptr;
+    }
+    if (!m_fileToActivateAfterLoading.isEmpty()) {
+        activateWindowWithFile(m_fileToActivateAfterLoading);
+        m_fileToActivateAfterLoading.clear();
+    }
 }
 
 void QC_ApplicationWindow::changeDrawingOptions(int tabToShow){
@@ -1480,8 +1573,13 @@ void QC_ApplicationWindow::slotOptionsGeneral() {
         m_statusbarManager->loadSettings();
         onCADTabBarIndexChanged(0); // force update if settings changed
 
-        doForEachSubWindowGraphicView([this](QG_GraphicView *gv, const QC_MDIWindow* w){
+        bool unitlessGrid = LC_GET_ONE_BOOL("Appearance", "UnitlessGrid", true);
+        doForEachSubWindowGraphicView([this, unitlessGrid](QG_GraphicView *gv, const QC_MDIWindow* w){
             gv->loadSettings();
+            RS_Graphic* graphic = w->getGraphic();
+            if (graphic != nullptr) {
+                graphic->setUnitlessGrid(unitlessGrid);
+            }
             if (w == m_activeMdiSubWindow) {
                 gv->redraw();
             }
@@ -1660,6 +1758,32 @@ void QC_ApplicationWindow::reloadStyleSheet() {
     m_styleHelper->reloadStyleSheet();
 }
 
+/**
+ * Starts collecting of rendering statistics, or stops it and saves collected statistics as JSON.
+ * The trace is saved next to them, in Chrome trace format.
+ */
+void QC_ApplicationWindow::toggleProfiler(bool on) {
+    if (on == LC_Profiler::isEnabled()) {
+        return;
+    }
+    if (on) {
+        LC_PROFILER->reset();
+        LC_PROFILER->setEnabled(true);
+        return;
+    }
+    LC_PROFILER->setEnabled(false);
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save Profiling Results"), QString(),
+                                                    tr("JSON files (*.json)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+    QFileInfo fileInfo(fileName);
+    QString traceFileName = fileInfo.dir().filePath(fileInfo.completeBaseName() + ".trace.json");
+    if (!LC_PROFILER->exportJson(fileName) || !LC_PROFILER->exportChromeTrace(traceFileName)) {
+        QMessageBox::warning(this, tr("Profile Rendering"), tr("Unable to save profiling results to %1").arg(fileName));
+    }
+}
+
 bool QC_ApplicationWindow::eventFilter(QObject *obj, QEvent *event) {
     if (QEvent::FileOpen == event->type()) {
         auto *openEvent = static_cast<QFileOpenEvent *>(event);
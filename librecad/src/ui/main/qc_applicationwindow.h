@@ -40,6 +40,7 @@ class LC_AppWindowDialogsInvoker;
 class LC_CreatorInvoker;
 class LC_CustomStyleHelper;
 class LC_DefaultActionContext;
+class LC_DocumentsLoader;
 class LC_GridViewInvoker;
 class LC_InfoCursorSettingsManager;
 class LC_LastOpenFilesOpener;
@@ -70,9 +71,11 @@ class QG_PenToolBar;
 class QG_RecentFiles;
 class QG_SelectionWidget;
 class QG_SnapToolBar;
+class QProgressDialog;
 class QSplashScreen;
 class RS_ActionInterface;
 class RS_Block;
+class RS_Graphic;
 class RS_Pen;
 class TwoStackedLabels;
 
@@ -209,6 +212,7 @@ public slots:
     void setPreviousZoomEnable(bool enable);
     void widgetOptionsDialog();
     void reloadStyleSheet();
+    void toggleProfiler(bool on);
     void updateGridStatus(const QString&);
     void showDeviceOptions();
     void updateDevice(const QString&);
@@ -299,6 +303,7 @@ public:
  * opens the given file.
  */
     void openFile(const QString& fileName, RS2::FormatType type);
+    void openFiles(const QStringList& fileNames, const QString& fileToActivate = QString());
     void changeDrawingOptions(int tabIndex);
     void closeWindow(QC_MDIWindow* w) override;
     QG_LibraryWidget* getLibraryWidget(){return m_libraryWidget;}
@@ -320,6 +325,10 @@ protected:
     void updateCoordinateWidgetFormat();
     void updateWidgetsAsDocumentLoaded(const QC_MDIWindow *w);
     void autoZoomAfterLoad(QG_GraphicView *graphicView);
+    void finishFileOpening(QC_MDIWindow *w, const QString &fileName);
+    void onBackgroundDocumentLoaded(RS_Graphic *graphic, const QString &fileName);
+    void onBackgroundLoadingProgress(int loaded, int total);
+    void onBackgroundLoadingFinished();
     bool newDrawingFromTemplate(const QString &fileName, QC_MDIWindow* w = nullptr);
 	void doActivate(QMdiSubWindow* w) override;
     void enableFileActions(const QC_MDIWindow* w);
@@ -415,6 +424,10 @@ protected:
     QList<QAction*> m_recentFilesActionList;
 
     QStringList openedFiles;
+    // several files at once are loaded in background
+    LC_DocumentsLoader* m_documentsLoader {nullptr};
+    QProgressDialog* m_documentsLoadingProgress {nullptr};
+    QString m_fileToActivateAfterLoading;
     QList<QAction*> m_actionsToDisableInPrintPreviewList;
 
 
@@ -291,31 +291,42 @@ bool QC_MDIWindow::loadDocument(const QString& fileName, RS2::FormatType type) {
     bool loaded = m_documentsStorage->loadDocument(m_document, fileName, type);
     addWidgetsListeners();
     if (loaded) {
-        RS_Graphic* graphic = m_document->getGraphic();
-        if (graphic != nullptr) {
-            RS_GraphicView *gv = graphic->getGraphicView(); // fixme - eliminate this dependency!
-            if (gv != nullptr) {
-                // fixme - sand - review and probably move initialization of UCS - as normal support of VIEWPORT will be available
-                // todo - not sure whether this is right place for setting up current wcs.
-                // Actually, it seems that it's better to rely on reading viewport (were setting for the offset and zoom are set.
-                // however, must probably with proper support of VIEW, they will be reworked too..
-                // So let it have here for now so far
-                LC_GraphicViewport* viewport = gv->getViewPort();
-                viewport->initAfterDocumentOpen();
-            }
-        }
+        initAfterDocumentLoaded(fileName);
+    }
+    return loaded;
+}
 
-        // fixme - sand - move support of fonts in some separate space?
-        if (fileName.endsWith(".lff") || fileName.endsWith(".cxf")) {
-            // fixme - sand - move to upper layer
-            drawChars();
-            m_graphicView->zoomAuto(false);
-        } else
-            m_graphicView->redraw();
-    } else {
+/**
+ * Takes ownership of the document, that was loaded in background before this window was created.
+ */
+void QC_MDIWindow::adoptLoadedDocument(const QString& fileName) {
+    m_owner = true;
+    m_documentsStorage->initLoadedGraphic(m_document->getGraphic(), fileName);
+    initAfterDocumentLoaded(fileName);
+}
 
+void QC_MDIWindow::initAfterDocumentLoaded(const QString& fileName) {
+    RS_Graphic* graphic = m_document->getGraphic();
+    if (graphic != nullptr) {
+        RS_GraphicView *gv = graphic->getGraphicView(); // fixme - eliminate this dependency!
+        if (gv != nullptr) {
+            // fixme - sand - review and probably move initialization of UCS - as normal support of VIEWPORT will be available
+            // todo - not sure whether this is right place for setting up current wcs.
+            // Actually, it seems that it's better to rely on reading viewport (were setting for the offset and zoom are set.
+            // however, must probably with proper support of VIEW, they will be reworked too..
+            // So let it have here for now so far
+            LC_GraphicViewport* viewport = gv->getViewPort();
+            viewport->initAfterDocumentOpen();
+        }
     }
-    return loaded;
+
+    // fixme - sand - move support of fonts in some separate space?
+    if (fileName.endsWith(".lff") || fileName.endsWith(".cxf")) {
+        // fixme - sand - move to upper layer
+        drawChars();
+        m_graphicView->zoomAuto(false);
+    } else
+        m_graphicView->redraw();
 }
 
 /**
@@ -50,6 +50,7 @@ public slots:
     void slotFileNew();
     bool loadDocumentFromTemplate(const QString &fileName, RS2::FormatType type);
     bool loadDocument(const QString &fileName, RS2::FormatType type);
+    void adoptLoadedDocument(const QString &fileName);
     bool saveDocument(bool &cancelled, bool isAutoSave = false);
     bool autoSaveDocument(QString &autosaveFileName);
     bool saveDocumentAs(bool &cancelled);
@@ -121,6 +122,7 @@ protected:
     void drawChars(); // fime - sand - files - refactor and remove from there!
     void closeEvent(QCloseEvent *) override;
     void addWidgetsListeners();
+    void initAfterDocumentLoaded(const QString &fileName);
     void setupGraphicView(QWidget *parent, bool printPreview, LC_ActionContext* actionContext);
 };
 #endif
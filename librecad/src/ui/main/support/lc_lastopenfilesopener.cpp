@@ -57,19 +57,19 @@ void LC_LastOpenFilesOpener::openLastOpenFiles(QStringList &fileList,  QSplashSc
             }
         }
         if (!fileList.isEmpty()) {
-            for (auto & it : fileList) {
-                if (splash != nullptr) {
-                    auto message = QObject::tr("Loading File %1..").arg(QDir::toNativeSeparators(it));
-                    splash->showMessage(message,Qt::AlignRight | Qt::AlignBottom, Qt::black);
-                    qApp->processEvents();
-                }
-                m_appWindow->openFile(it);
-                files_loaded = true;
+            if (splash != nullptr) {
+                auto message = fileList.size() == 1
+                                   ? QObject::tr("Loading File %1..").arg(QDir::toNativeSeparators(fileList.first()))
+                                   : QObject::tr("Loading %1 Files..").arg(fileList.size());
+                splash->showMessage(message,Qt::AlignRight | Qt::AlignBottom, Qt::black);
+                qApp->processEvents();
             }
+            QString activeFile;
             if (reopenLastFiles) {
-                QString activeFile = LC_GET_STR("LastOpenFilesActive", "");
-                m_appWindow->activateWindowWithFile(activeFile);
+                activeFile = LC_GET_STR("LastOpenFilesActive", "");
             }
+            m_appWindow->openFiles(fileList, activeFile);
+            files_loaded = true;
         }
 
         RS_DEBUG->print("main: loading files: OK");
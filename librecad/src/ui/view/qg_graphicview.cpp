@@ -346,10 +346,19 @@ void QG_GraphicView::createViewRenderer() {
     }
 }
 
-void QG_GraphicView::layerToggled(RS_Layer *) {
+void QG_GraphicView::layerToggled(RS_Layer *layer) {
     const RS_EntityContainer::LC_SelectionInfo &info = getContainer()->getSelectionInfo();
     RS_DIALOGFACTORY->updateSelectionWidget(info.count, info.length);
-    redraw(RS2::RedrawDrawing);
+    redrawLayer(layer);
+}
+
+/**
+ * Redraws the drawing after change of the given layer. Depending on the renderer, only entities that depend on
+ * the layer may be rendered again. nullptr means that several layers are changed.
+ */
+void QG_GraphicView::redrawLayer(RS_Layer* layer) {
+    getRenderer()->invalidateLayer(layer);
+    update();
 }
 
 /**
@@ -78,15 +78,25 @@ public:
     void loadSettings() override;
 
     // Methods from RS_LayerListListener Interface:
-    void layerEdited(RS_Layer*) override{
-        redraw(RS2::RedrawDrawing);
+    void layerEdited(RS_Layer* layer) override{
+        redrawLayer(layer);
     }
     void layerRemoved(RS_Layer*) override{
         redraw(RS2::RedrawDrawing);
     }
 
     void layerToggled(RS_Layer*) override;
+    void layerToggledLock(RS_Layer* layer) override{
+        redrawLayer(layer);
+    }
+    void layerToggledPrint(RS_Layer* layer) override{
+        redrawLayer(layer);
+    }
+    void layerToggledConstruction(RS_Layer* layer) override{
+        redrawLayer(layer);
+    }
     void layerActivated(RS_Layer *) override;
+    void redrawLayer(RS_Layer* layer);
 
     /**
      * @brief setOffset
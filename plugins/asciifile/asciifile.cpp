@@ -10,7 +10,11 @@
 /*  along with this program.  If not, see <http://www.gnu.org/licenses/>.    */
 /*****************************************************************************/
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cmath>
+#include <iterator>
 
 #include <QtPlugin>
 #include <QPicture>
@@ -23,6 +27,8 @@
 #include <QPushButton>
 #include <QFileDialog>
 #include <QSettings>
+#include <QThread>
+#include <QThreadPool>
 
 #include <QMessageBox>
 
@@ -52,6 +58,47 @@ void AsciiFile::execComm(Document_Interface *doc,
 
 #define POINT 12
 
+namespace {
+// size of blocks read from file, lines of a block are parsed in parallel
+constexpr qint64 READ_BLOCK_SIZE = 16 * 1024 * 1024;
+// blocks smaller than this are parsed by one thread
+constexpr qint64 PARALLEL_PARSE_SIZE = 256 * 1024;
+// fields used by the longest record (odb)
+constexpr int MAX_FIELDS = 7;
+
+struct Field {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    bool isEmpty() const { return begin == end; }
+};
+
+bool toDouble(Field field, double& value)
+{
+    // QString::toDouble() used before accepted surrounding whitespace and a leading '+'
+    while (field.begin != field.end && std::isspace(static_cast<unsigned char>(*field.begin)))
+        ++field.begin;
+    while (field.begin != field.end && std::isspace(static_cast<unsigned char>(*(field.end - 1))))
+        --field.end;
+    if (field.begin != field.end && *field.begin == '+')
+        ++field.begin;
+    if (field.isEmpty())
+        return false;
+#if defined(__cpp_lib_to_chars)
+    auto [ptr, ec] = std::from_chars(field.begin, field.end, value);
+    return ec == std::errc() && ptr == field.end;
+#else
+    bool ok = false;
+    value = QByteArray::fromRawData(field.begin, static_cast<int>(field.end - field.begin)).toDouble(&ok);
+    return ok;
+#endif
+}
+
+QString toString(Field field)
+{
+    return QString::fromUtf8(field.begin, static_cast<int>(field.end - field.begin));
+}
+}
+
 imgLabel::imgLabel(QWidget * parent, Qt::WindowFlags f) :
     QLabel(parent, f)
 {
@@ -327,52 +374,44 @@ bool dibPunto::failGUI(QString *msg)
 
 void dibPunto::procesFile(Document_Interface *doc)
 {
-    QString sep;
+    char sep;
+    bool skip = false;
     QMessageBox::information(this, "Info", "dibpunto procesFile");
     currDoc = doc;
 
 //Warning, can change adding or reordering "formatedit"
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-    Qt::SplitBehaviorFlags skip = Qt::KeepEmptyParts;
-#else
-    QString::SplitBehavior skip = QString::KeepEmptyParts;
-#endif
     switch (formatedit->currentIndex()) {
     case 0:
-        sep = " ";
+        sep = ' ';
         break;
     case 3:
-        sep = " ";
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-        skip = Qt::SkipEmptyParts;
-#else
-        skip = QString::SkipEmptyParts;
-#endif
+        sep = ' ';
+        skip = true;
         break;
     case 2:
-        sep = ",";
+        sep = ',';
         break;
     default:
-        sep = "\t";
+        sep = '\t';
     }
     if (!QFile::exists(fileedit->text()) ) {
         QMessageBox::critical ( this, "DibPunto", QString(tr("The file %1 not exist")).arg(fileedit->text()) );
         return;
     }
     QFile infile(fileedit->text());
-    if (!infile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!infile.open(QIODevice::ReadOnly)) {
         QMessageBox::critical ( this, "DibPunto", QString(tr("Can't open the file %1")).arg(fileedit->text()) );
          return;
     }
 
+    readLabels = ptelev->checkOn() || ptnumber->checkOn() || ptcode->checkOn();
 //Warning, can change adding or reordering "formatedit"
-    if (formatedit->currentIndex() == 4)
-        procesfileODB(&infile, sep);
-    else
-        procesfileNormal(&infile, sep, skip);
+    readPoints(&infile, sep, skip, formatedit->currentIndex() == 4);
     infile.close ();
     QString currlay = currDoc->getCurrentLayer();
 
+    // the whole import is undone at once
+    currDoc->startUndoCycle();
     if (pt2d->checkOn() == true)
         draw2D();
     if (pt3d->checkOn() == true)
@@ -388,62 +427,42 @@ void dibPunto::procesFile(Document_Interface *doc)
     /* draw lines in current layer */
     if ( connectPoints->isChecked() )
         drawLine();
+    currDoc->endUndoCycle();
 
     currDoc = nullptr;
 
 }
 
+std::vector<QPointF> dibPunto::pointsCoordinates() const
+{
+    std::vector<QPointF> points;
+    points.reserve(dataList.size());
+    for (const PointData& pd: dataList)
+        points.emplace_back(pd.x, pd.y);
+    return points;
+}
+
 void dibPunto::drawLine()
 {
-    QPointF prevP, nextP;
-    int i;
-
-    for (i = 0; i < dataList.size(); ++i) {
-        PointData *pd = dataList.at(i);
-        if (!pd->x.isEmpty() && !pd->y.isEmpty()){
-            prevP.setX(pd->x.toDouble());
-            prevP.setY(pd->y.toDouble());
-            break;
-        }
-    }
-    for (; i < dataList.size(); ++i) {
-        PointData *pd = dataList.at(i);
-        if (!pd->x.isEmpty() && !pd->y.isEmpty()){
-            nextP.setX(pd->x.toDouble());
-            nextP.setY(pd->y.toDouble());
-            currDoc->addLine(&prevP, &nextP);
-            prevP = nextP;
-        }
-    }
+    if (dataList.size() < 2)
+        return;
+    std::vector<Plug_VertexData> vertices;
+    vertices.reserve(dataList.size());
+    for (const PointData& pd: dataList)
+        vertices.emplace_back(QPointF(pd.x, pd.y), 0.0);
+    currDoc->addPolyline(vertices);
 }
 
 void dibPunto::draw2D()
 {
-    QPointF pt;
     currDoc->setLayer(pt2d->getLayer());
-    for (int i = 0; i < dataList.size(); ++i) {
-        PointData *pd = dataList.at(i);
-        if (!pd->x.isEmpty() && !pd->y.isEmpty()){
-            pt.setX(pd->x.toDouble());
-            pt.setY(pd->y.toDouble());
-            currDoc->addPoint(&pt);
-        }
-    }
+    currDoc->addPoints(pointsCoordinates());
 }
 void dibPunto::draw3D()
 {
-    QPointF pt;
     currDoc->setLayer(pt3d->getLayer());
-    for (int i = 0; i < dataList.size(); ++i) {
-        PointData *pd = dataList.at(i);
-        if (!pd->x.isEmpty() && !pd->y.isEmpty()){
-            pt.setX(pd->x.toDouble());
-            pt.setY(pd->y.toDouble());
-/*RLZ:3d support            if (pd->z.isEmpty()) pt.setZ(0.0);
-            else  pt.setZ(pd->z.toDouble());*/
-            currDoc->addPoint(&pt);
-        }
-    }
+/*RLZ:3d support, z is not kept as coordinate yet */
+    currDoc->addPoints(pointsCoordinates());
 }
 
 void dibPunto::calcPos(DPI::VAlign *v, DPI::HAlign *h, double sep,
@@ -503,7 +522,7 @@ void dibPunto::calcPos(DPI::VAlign *v, DPI::HAlign *h, double sep,
 
 void dibPunto::drawNumber()
 {
-    double incx, incy, newx, newy;
+    double incx, incy;
     DPI::VAlign va;
     DPI::HAlign ha;
     calcPos(&va, &ha, ptnumber->getSeparation(),
@@ -511,21 +530,19 @@ void dibPunto::drawNumber()
 
     currDoc->setLayer(ptnumber->getLayer());
     QString sty = ptnumber->getStyleStr();
-    for (int i = 0; i < dataList.size(); ++i) {
-        PointData *pd = dataList.at(i);
-        if (!pd->x.isEmpty() && !pd->y.isEmpty() && !pd->number.isEmpty()){
-            newx = pd->x.toDouble() + incx;
-            newy = pd->y.toDouble() + incy;
-            QPointF pt(newx,newy);
-            currDoc->addText(pd->number, sty, &pt, ptnumber->getHeightStr().toDouble(), 0.0, ha, va);
+    double height = ptnumber->getHeight();
+    for (size_t i = 0; i < dataList.size(); ++i) {
+        const QString& text = labelList[i].number;
+        if (!text.isEmpty()){
+            QPointF pt(dataList[i].x + incx, dataList[i].y + incy);
+            currDoc->addText(text, sty, &pt, height, 0.0, ha, va);
         }
     }
 }
 
 void dibPunto::drawElev()
 {
-
-    double incx, incy, newx, newy;
+    double incx, incy;
     DPI::VAlign va;
     DPI::HAlign ha;
     calcPos(&va, &ha, ptelev->getSeparation(),
@@ -533,19 +550,18 @@ void dibPunto::drawElev()
 
     currDoc->setLayer(ptelev->getLayer());
     QString sty = ptelev->getStyleStr();
-    for (int i = 0; i < dataList.size(); ++i) {
-        PointData *pd = dataList.at(i);
-        if (!pd->x.isEmpty() && !pd->y.isEmpty() && !pd->z.isEmpty()){
-            newx = pd->x.toDouble() + incx;
-            newy = pd->y.toDouble() + incy;
-            QPointF pt(newx,newy);
-            currDoc->addText(pd->z, sty, &pt, ptelev->getHeightStr().toDouble(), 0.0, ha, va);
+    double height = ptelev->getHeight();
+    for (size_t i = 0; i < dataList.size(); ++i) {
+        const QString& text = labelList[i].z;
+        if (!text.isEmpty()){
+            QPointF pt(dataList[i].x + incx, dataList[i].y + incy);
+            currDoc->addText(text, sty, &pt, height, 0.0, ha, va);
         }
     }
 }
 void dibPunto::drawCode()
 {
-    double incx, incy, newx, newy;
+    double incx, incy;
     DPI::VAlign va;
     DPI::HAlign ha;
     calcPos(&va, &ha, ptcode->getSeparation(),
@@ -553,95 +569,140 @@ void dibPunto::drawCode()
 
     currDoc->setLayer(ptcode->getLayer());
     QString sty = ptcode->getStyleStr();
-    for (int i = 0; i < dataList.size(); ++i) {
-        PointData *pd = dataList.at(i);
-        if (!pd->x.isEmpty() && !pd->y.isEmpty() && !pd->code.isEmpty()){
-            newx = pd->x.toDouble() + incx;
-            newy = pd->y.toDouble() + incy;
-            QPointF pt(newx,newy);
-            currDoc->addText(pd->code, sty, &pt, ptcode->getHeightStr().toDouble(), 0.0, ha, va);
+    double height = ptcode->getHeight();
+    for (size_t i = 0; i < dataList.size(); ++i) {
+        const QString& text = labelList[i].code;
+        if (!text.isEmpty()){
+            QPointF pt(dataList[i].x + incx, dataList[i].y + incy);
+            currDoc->addText(text, sty, &pt, height, 0.0, ha, va);
         }
     }
 }
 
-void dibPunto::procesfileODB(QFile* file, QString sep)
+/**
+ * Reads points from the file by blocks, lines of each block are parsed in parallel.
+ * Records without valid x and y coordinates are skipped.
+ */
+void dibPunto::readPoints(QFile* file, char sep, bool skipEmpty, bool odb)
 {
-    QStringList data;
-    PointData *pd;
-
+    dataList.clear();
+    labelList.clear();
+    const int threads = std::max(1, QThread::idealThreadCount());
+    QByteArray block;
     while (!file->atEnd()) {
-        QString line = file->readLine();
-        line.remove ( line.size()-2, 1);
-        data = line.split(sep);
-        pd = new PointData;
-        int i = 0;
-        int j = data.size();
-        if (i<j && data.at(i).compare("4")==0 ){
-            i = i+2;
-            if (i<j) pd->x = data.at(i); else pd->x = QString();
-            i++;
-            if (i<j) pd->y = data.at(i); else pd->y = QString();
-            i++;
-            if (i<j) pd->z = data.at(i); else pd->z = QString();
-            i++;
-            if (i<j) pd->number = data.at(i); else pd->number = QString();
-            i++;
-            if (i<j) pd->code = data.at(i); else pd->code = QString();
+        block.append(file->read(READ_BLOCK_SIZE));
+        qsizetype blockEnd = block.size();
+        if (!file->atEnd()) {
+            // the last incomplete line is left for the next block
+            blockEnd = block.lastIndexOf('\n') + 1;
+            if (blockEnd == 0)
+                continue;
         }
-        dataList.append(pd);
-    }
+        const char* begin = block.constData();
+        const char* end = begin + blockEnd;
+
+        int parts = blockEnd < PARALLEL_PARSE_SIZE ? 1 : threads;
+        std::vector<std::vector<PointData>> partPoints(parts);
+        std::vector<std::vector<PointLabels>> partLabels(parts);
+        std::vector<const char*> bounds{begin};
+        for (int i = 1; i < parts; ++i) {
+            const char* bound = std::max(bounds.back(), begin + blockEnd * i / parts);
+            bound = std::find(bound, end, '\n');
+            bounds.push_back(bound == end ? end : bound + 1);
+        }
+        bounds.push_back(end);
+
+        QThreadPool threadPool;
+        for (int i = 1; i < parts; ++i) {
+            threadPool.start([this, &bounds, &partPoints, &partLabels, i, sep, skipEmpty, odb]() {
+                parseLines(bounds[i], bounds[i + 1], sep, skipEmpty, odb, partPoints[i], partLabels[i]);
+            });
+        }
+        parseLines(bounds[0], bounds[1], sep, skipEmpty, odb, partPoints[0], partLabels[0]);
+        threadPool.waitForDone();
 
+        for (int i = 0; i < parts; ++i) {
+            dataList.insert(dataList.end(), partPoints[i].begin(), partPoints[i].end());
+            std::move(partLabels[i].begin(), partLabels[i].end(), std::back_inserter(labelList));
+        }
+        block.remove(0, blockEnd);
+    }
 }
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-void dibPunto::procesfileNormal(QFile* file, QString sep, Qt::SplitBehaviorFlags skip)
-#else
-void dibPunto::procesfileNormal(QFile* file, QString sep, QString::SplitBehavior skip)
-#endif
+/**
+ * Parses points in lines from begin to end. Called from worker threads, must not touch the dialog.
+ */
+void dibPunto::parseLines(const char* begin, const char* end, char sep, bool skipEmpty, bool odb,
+                          std::vector<PointData>& points, std::vector<PointLabels>& labels) const
 {
-    //    QString outname, sep;
-    QStringList data;
-    PointData *pd;
-    while (!file->atEnd()) {
-        QString line = file->readLine();
-		if(line.isEmpty()) continue;
-        line.remove ( line.size()-1, 1);
-        data = line.split(sep, skip);
-        pd = new PointData;
-        int i = 0;
-        switch(data.size()){
-        case 0:
-        case 1:
-            delete pd;
-            continue;
-
-            //allow reading in raw 2D ascii data in format:
-            // x y
-        case 2:
-            pd->x = data.at(0);
-            pd->y = data.at(1);
-            break;
-        default:
-        case 5:
-            pd->code=data.at(4);
-            // fall-through
-        case 4:
-            pd->z = data.at(3);
-            // fall-through
-        case 3:
-            pd->number = data.at(i);
-            pd->x = data.at(1);
-            pd->y = data.at(2);
-            break;
+    Field data[MAX_FIELDS];
+    while (begin < end) {
+        const char* lineEnd = std::find(begin, end, '\n');
+        const char* next = lineEnd == end ? end : lineEnd + 1;
+        if (lineEnd != begin && *(lineEnd - 1) == '\r')
+            --lineEnd;
+        // odb lines end with a character that is not part of the data
+        if (odb && lineEnd != begin)
+            --lineEnd;
+
+        int fields = 0;
+        for (const char* fb = begin; fields < MAX_FIELDS;) {
+            const char* fe = std::find(fb, lineEnd, sep);
+            if (!skipEmpty || fe != fb)
+                data[fields++] = Field{fb, fe};
+            if (fe == lineEnd)
+                break;
+            fb = fe + 1;
+        }
+        begin = next;
+
+        Field number, x, y, z, code;
+        if (odb) {
+            if (fields == 0 || data[0].end - data[0].begin != 1 || *data[0].begin != '4')
+                continue;
+            if (fields > 2) x = data[2];
+            if (fields > 3) y = data[3];
+            if (fields > 4) z = data[4];
+            if (fields > 5) number = data[5];
+            if (fields > 6) code = data[6];
+        } else {
+            switch(fields){
+            case 0:
+            case 1:
+                continue;
+
+                //allow reading in raw 2D ascii data in format:
+                // x y
+            case 2:
+                x = data[0];
+                y = data[1];
+                break;
+            default:
+            case 5:
+                code = data[4];
+                // fall-through
+            case 4:
+                z = data[3];
+                // fall-through
+            case 3:
+                number = data[0];
+                x = data[1];
+                y = data[2];
+                break;
+            }
         }
-        dataList.append(pd);
+
+        PointData pd;
+        if (!toDouble(x, pd.x) || !toDouble(y, pd.y))
+            continue;
+        points.push_back(pd);
+        if (readLabels)
+            labels.push_back(PointLabels{toString(number), toString(z), toString(code)});
     }
 }
 
 dibPunto::~dibPunto()
 {
-    while (!dataList.isEmpty())
-         delete dataList.takeFirst();
 }
 
 void dibPunto::readSettings()
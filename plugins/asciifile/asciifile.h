@@ -13,6 +13,8 @@
 #ifndef DRAWPOINTS_H
 #define DRAWPOINTS_H
 
+#include <vector>
+
 #include <QWidget>
 #include <QFile>
 #include <QLabel>
@@ -27,7 +29,6 @@
 class pointBox;
 class textBox;
 class QVBoxLayout;
-struct PointData;
 
 class AsciiFile : public QObject, QC_PluginInterface
 {
@@ -46,6 +47,19 @@ namespace DPT {
     enum txtposition {N, S, E, O, NE, SE, SO, NO};
 }
 
+struct PointData
+{
+    double x;
+    double y;
+};
+
+struct PointLabels
+{
+    QString number;
+    QString z;
+    QString code;
+};
+
 class dibPunto : public QDialog
 {
     Q_OBJECT
@@ -63,12 +77,10 @@ public slots:
 private:
     void readSettings();
     void writeSettings();
-    void procesfileODB(QFile* file, QString sep);
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-    void procesfileNormal(QFile* file, QString sep, Qt::SplitBehaviorFlags skip = Qt::KeepEmptyParts);
-#else
-    void procesfileNormal(QFile* file, QString sep, QString::SplitBehavior skip = QString::KeepEmptyParts);
-#endif
+    void readPoints(QFile* file, char sep, bool skipEmpty, bool odb);
+    void parseLines(const char* begin, const char* end, char sep, bool skipEmpty, bool odb,
+                    std::vector<PointData>& points, std::vector<PointLabels>& labels) const;
+    std::vector<QPointF> pointsCoordinates() const;
     void drawLine();
     void draw2D();
     void draw3D();
@@ -89,7 +101,11 @@ private:
     QLineEdit *fileedit;
     QComboBox *formatedit;
     QCheckBox *connectPoints;
-    QList<PointData*> dataList;
+    //! imported points, coordinates are kept apart of labels so files with millions of points fit in memory
+    std::vector<PointData> dataList;
+    //! labels of imported points, filled only if any label is drawn
+    std::vector<PointLabels> labelList;
+    bool readLabels = false;
 
     Document_Interface *currDoc;
 
@@ -164,13 +180,4 @@ private:
     imgLabel *img;
 };
 /***********/
-struct PointData
-{
-    QString number;
-    QString x;
-    QString y;
-    QString z;
-    QString code;
-};
-/***********/
 #endif // ECHOPLUG_H
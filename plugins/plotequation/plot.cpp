@@ -8,8 +8,10 @@
 #include "document_interface.h"
 #include "plot.h"
 #include "plotdialog.h"
+#include "plotsampler.h"
 #include <muParser.h>
 #include <QDebug>
+#include <QElapsedTimer>
 
 mu::string_type toMUPString(const QString &str)
 {
@@ -38,7 +40,7 @@ PluginCapabilities plot::getCapabilities() const
     return pluginCapabilities;
 }
 
-void plot::execComm([[maybe_unused]] Document_Interface *doc, QWidget *parent, [[maybe_unused]] QString cmd)
+void plot::execComm(Document_Interface *doc, QWidget *parent, [[maybe_unused]] QString cmd)
 {
     QString equation1;
     QString equation2;
@@ -46,9 +48,7 @@ void plot::execComm([[maybe_unused]] Document_Interface *doc, QWidget *parent, [
     QString endValue;
     double stepSize;
 
-    QList<double> xValues;
-    QList<double> yValues1;
-    QList<double> yValues2;
+    std::vector<QPointF> points;
     plotDialog::EntityType lineType=plotDialog::Polyline;
 
     plotDialog plotDlg(parent);
@@ -61,6 +61,9 @@ void plot::execComm([[maybe_unused]] Document_Interface *doc, QWidget *parent, [
         plotDlg.getValues(equation1, equation2, startValue, endValue, stepSize);
         lineType=plotDlg.getEntityType();
 
+        QElapsedTimer timer;
+        timer.start();
+        size_t evaluations = 0;
         try{
             mu::Parser p;
             p.DefineConst(_T("pi"),M_PI);
@@ -73,37 +76,24 @@ void plot::execComm([[maybe_unused]] Document_Interface *doc, QWidget *parent, [
             p.SetExpr(toMUPString(endValue));
             endVal = p.Eval();
 
-            p.SetExpr(toMUPString(equation1));
-
-            for(equationVariable = startVal; equationVariable <= endVal; equationVariable += stepSize)
-            {//calculate the values of the first equation
-                xValues.append(equationVariable);
-                yValues1.append(p.Eval());
-            }
-
-            if(!equation2.isEmpty())
-            {//calculate the values of the second equation
-                p.SetExpr(toMUPString(equation2));
-                for(int i = 0; i < xValues.size(); ++i)
-                {
-                    equationVariable = xValues.at(i);
-                    yValues2.append(p.Eval());
-                }
-            }
+            plotSampler sampler(doc, equation1, equation2);
+            if (plotDlg.isAdaptive())
+                points = sampler.sampleAdaptive(startVal, endVal, stepSize, plotDlg.getTolerance());
+            else
+                points = sampler.sampleUniform(startVal, endVal, stepSize);
+            evaluations = sampler.evaluations();
         }
         catch (mu::Parser::exception_type &e)
         {
             mu::console() << e.GetMsg() << std::endl;
         }
+        doc->commandMessage(tr("Plot: %1 evaluations, %2 points in %3 ms")
+                            .arg(evaluations).arg(points.size()).arg(timer.elapsed()));
 
-        QList<double> const& xpoints=(equation2.isEmpty())?xValues:yValues1;
-        QList<double> const& ypoints=(equation2.isEmpty())?yValues1:yValues2;
+        if (points.size() < 2)
+            return;
 
         if (lineType == plotDialog::LineSegments || lineType == plotDialog::SplinePoints){
-            std::vector<QPointF> points;
-            for(int i=0; i< xpoints.size(); ++i){
-                points.emplace_back(QPointF(xpoints[i], ypoints[i]));
-            }
             if (lineType == plotDialog::SplinePoints){
                 //TODO add option for splinepoints: closed
                 //hardcoded to false now
@@ -111,11 +101,12 @@ void plot::execComm([[maybe_unused]] Document_Interface *doc, QWidget *parent, [
             } else
                 doc->addLines(points, false);
         } else { //default plotDialog::Polyline
-            std::vector<Plug_VertexData> points;
-            for(int i=0; i< xpoints.size(); ++i){
-                points.emplace_back(Plug_VertexData(QPointF(xpoints[i], ypoints[i]), 0.0));
+            std::vector<Plug_VertexData> vertices;
+            vertices.reserve(points.size());
+            for(const QPointF& point: points){
+                vertices.emplace_back(point, 0.0);
             }
-            doc->addPolyline(points, false);
+            doc->addPolyline(vertices, false);
         }
 
     }
@@ -5,6 +5,7 @@
 #include <QLineEdit>
 #include <QPushButton>
 #include <QComboBox>
+#include <QCheckBox>
 #include <QDebug>
 
 Q_DECLARE_METATYPE(plotDialog::EntityType)
@@ -18,7 +19,9 @@ plotDialog::plotDialog(QWidget *parent) :
     description = new QLabel(tr("This plugin allows you to plot mathematical equations.\n"
                                 "If you don't want to use the parametric form, just leave out \"Equation2\".\n"
                                 "You can use pi when you need the value of pi (i.e. (3*pi)).\n"
-                                "Use t or x in your equation as a variable/parameter.\n"));
+                                "Use t or x in your equation as a variable/parameter.\n"
+                                "With adaptive sampling the step size is the largest step, steps are halved\n"
+                                "until the curve is within the tolerance from its chords.\n"));
     lblEquasion1 = new QLabel(tr("Equation 1:"));
     lblEquasion2 = new QLabel(tr("Equation 2:"));
     lnedEquasion1 = new QLineEdit(this);
@@ -63,15 +66,26 @@ plotDialog::plotDialog(QWidget *parent) :
 
     mainLayout->addWidget(m_pTypeSelection, 7, 0);
 
+    m_pAdaptive = new QCheckBox(tr("Adaptive sampling"), this);
+    lblTolerance = new QLabel(tr("tolerance:"));
+    lnedTolerance = new QLineEdit(this);
+    lnedTolerance->setMaximumWidth(50);
+    lnedTolerance->setText("0.01");
+    lnedTolerance->setEnabled(false);
+    mainLayout->addWidget(m_pAdaptive, 7, 1);
+    mainLayout->addWidget(lblTolerance, 8, 0);
+    mainLayout->addWidget(lnedTolerance, 8, 1);
+
     buttonLayout->addWidget(btnAccept);
     buttonLayout->addWidget(btnCancel);
 
-    mainLayout->addLayout(buttonLayout, 8, 1);
+    mainLayout->addLayout(buttonLayout, 9, 1);
 
     setLayout(mainLayout);
 
     connect(btnAccept, SIGNAL(clicked()), this, SLOT(slotDrawButtonClicked()));
     connect(btnCancel, SIGNAL(clicked()), this, SLOT(reject()));
+    connect(m_pAdaptive, SIGNAL(toggled(bool)), lnedTolerance, SLOT(setEnabled(bool)));
 
 
 }
@@ -81,6 +95,17 @@ plotDialog::EntityType plotDialog::getEntityType() const
     return m_pTypeSelection->itemData(m_pTypeSelection->currentIndex()).value<plotDialog::EntityType>();
 }
 
+bool plotDialog::isAdaptive() const
+{
+    return m_pAdaptive->isChecked();
+}
+
+//largest allowed distance between the curve and its chords in adaptive sampling
+double plotDialog::getTolerance() const
+{
+    return tolerance;
+}
+
 //get the valuew that the user entered
 void plotDialog::getValues(QString& eq1, QString& eq2, QString& start, QString& end, double& step) const
 {
@@ -154,6 +179,21 @@ bool plotDialog::readInput()
         qDebug("could not convert step size");
         return false;
     }
+    if(stepSize <= 0.0)
+    {
+        qDebug("step size must be positive");
+        return false;
+    }
+
+    if(m_pAdaptive->isChecked())
+    {
+        tolerance = lnedTolerance->text().toDouble(&conv);
+        if(!conv || tolerance <= 0.0)
+        {
+            qDebug("could not convert tolerance");
+            return false;
+        }
+    }
 
     return true;
 }
@@ -11,6 +11,7 @@ class QPushButton;
 class QHBoxLayout;
 class QSpacerItem;
 class QComboBox;
+class QCheckBox;
 
 
 class plotDialog : public QDialog
@@ -27,6 +28,8 @@ public:
     ~plotDialog()=default;
     void getValues(QString& eq1, QString& eq2, QString &start, QString &end, double& step) const;
     EntityType getEntityType() const;
+    bool isAdaptive() const;
+    double getTolerance() const;
 
 public slots:
     void slotDrawButtonClicked();
@@ -37,6 +40,7 @@ private:
     QString startValue;
     QString endValue;
     double stepSize;
+    double tolerance = 0.0;
     QGridLayout *mainLayout;
     QHBoxLayout* buttonLayout;
     QLabel* description;
@@ -54,6 +58,9 @@ private:
     QPushButton* btnCancel;
     QSpacerItem* space;
     QComboBox* m_pTypeSelection;
+    QCheckBox* m_pAdaptive;
+    QLabel* lblTolerance;
+    QLineEdit* lnedTolerance;
 
     bool readInput();
 
@@ -0,0 +1,226 @@
+#include "plotsampler.h"
+#include "document_interface.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include <QThread>
+#include <QThreadPool>
+
+#include <muParser.h>
+
+mu::string_type toMUPString(const QString &str);
+
+namespace {
+//parameters evaluated by one bulk call, also the smallest share of a thread
+constexpr int BULK_SIZE = 8192;
+//limits refinement of segments in adaptive sampling, a segment is split in 2^MAX_DEPTH at most
+constexpr int MAX_DEPTH = 16;
+
+void setupParser(mu::Parser& p, double* variable)
+{
+    p.DefineConst(_T("pi"),M_PI);
+    p.DefineConst(_T("e"),M_E);
+    p.DefineVar(_T("x"), variable);
+    p.DefineVar(_T("t"), variable);
+}
+
+bool isFinite(const QPointF& p)
+{
+    return std::isfinite(p.x()) && std::isfinite(p.y());
+}
+
+//distance of p to the line through a and b
+double chordError(const QPointF& a, const QPointF& b, const QPointF& p)
+{
+    const QPointF ab = b - a;
+    const QPointF ap = p - a;
+    const double len = std::hypot(ab.x(), ab.y());
+    if (len <= 0.0) {
+        return std::hypot(ap.x(), ap.y());
+    }
+    return std::abs(ab.x() * ap.y() - ab.y() * ap.x()) / len;
+}
+
+void removeNonFinite(std::vector<QPointF>& points)
+{
+    points.erase(std::remove_if(points.begin(), points.end(), [](const QPointF& p){ return !isFinite(p); }),
+                 points.end());
+}
+
+//the variable of equation, if the application is able to evaluate it, empty otherwise
+QString sharedVariable(Document_Interface* doc, const QString& equation)
+{
+    if (doc == nullptr || equation.isEmpty()) {
+        return {};
+    }
+    std::vector<double> results;
+    for (const QString& variable: {QStringLiteral("x"), QStringLiteral("t")}) {
+        if (doc->evalBatch(equation, variable, {0.0}, results)) {
+            return variable;
+        }
+    }
+    return {};
+}
+}
+
+plotSampler::plotSampler(Document_Interface* doc, const QString& equation1, const QString& equation2):
+    m_doc(doc)
+  , m_equation1(equation1)
+  , m_equation2(equation2)
+  , m_variable1(sharedVariable(doc, equation1))
+  , m_variable2(sharedVariable(doc, equation2))
+{
+    //parse once here, so errors are reported to the caller instead of inside worker threads
+    double variable = 0.0;
+    mu::Parser p;
+    setupParser(p, &variable);
+    p.SetExpr(toMUPString(m_equation1));
+    p.Eval();
+    if (!m_equation2.isEmpty()) {
+        p.SetExpr(toMUPString(m_equation2));
+        p.Eval();
+    }
+}
+
+std::vector<QPointF> plotSampler::sampleUniform(double start, double end, double step) const
+{
+    if (!(step > 0.0) || end < start) {
+        return {};
+    }
+    //computed from the index rather than accumulated, so rounding errors don't drift
+    const size_t count = static_cast<size_t>(std::floor((end - start) / step * (1.0 + 1e-12))) + 1;
+    std::vector<double> parameters(count);
+    for (size_t i = 0; i < count; ++i) {
+        parameters[i] = start + step * i;
+    }
+    std::vector<QPointF> points = evaluate(parameters);
+    removeNonFinite(points);
+    return points;
+}
+
+std::vector<QPointF> plotSampler::sampleAdaptive(double start, double end, double step, double tolerance) const
+{
+    if (!(step > 0.0) || end < start) {
+        return {};
+    }
+    std::vector<double> parameters;
+    for (size_t i = 0; start + step * i < end; ++i) {
+        parameters.push_back(start + step * i);
+    }
+    parameters.push_back(end);
+    std::vector<QPointF> points = evaluate(parameters);
+
+    //refine level by level, midpoints of all segments of a level are evaluated by one bulk call
+    std::vector<size_t> segments(parameters.size() - 1);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        segments[i] = i;
+    }
+    for (int depth = 0; depth < MAX_DEPTH && !segments.empty(); ++depth) {
+        std::vector<double> middles(segments.size());
+        for (size_t i = 0; i < segments.size(); ++i) {
+            middles[i] = 0.5 * (parameters[segments[i]] + parameters[segments[i] + 1]);
+        }
+        const std::vector<QPointF> middlePoints = evaluate(middles);
+
+        //rebuild the arrays with the middle points of segments that are too far from their chords
+        std::vector<double> refinedParameters;
+        std::vector<QPointF> refinedPoints;
+        std::vector<size_t> refinedSegments;
+        refinedParameters.reserve(parameters.size() + segments.size());
+        refinedPoints.reserve(parameters.size() + segments.size());
+        size_t next = 0;
+        for (size_t i = 0; i < parameters.size(); ++i) {
+            refinedParameters.push_back(parameters[i]);
+            refinedPoints.push_back(points[i]);
+            if (next < segments.size() && segments[next] == i) {
+                const QPointF& a = points[i];
+                const QPointF& b = points[i + 1];
+                const QPointF& m = middlePoints[next];
+                if (isFinite(a) && isFinite(b) && isFinite(m) && chordError(a, b, m) > tolerance) {
+                    refinedSegments.push_back(refinedParameters.size() - 1);
+                    refinedParameters.push_back(middles[next]);
+                    refinedPoints.push_back(m);
+                    refinedSegments.push_back(refinedParameters.size() - 1);
+                }
+                ++next;
+            }
+        }
+        parameters.swap(refinedParameters);
+        points.swap(refinedPoints);
+        segments.swap(refinedSegments);
+    }
+    removeNonFinite(points);
+    return points;
+}
+
+std::vector<QPointF> plotSampler::evaluate(std::vector<double>& parameters) const
+{
+    const size_t count = parameters.size();
+    std::vector<QPointF> points(count);
+    m_evaluations += count;
+    const size_t chunks = (count + BULK_SIZE - 1) / BULK_SIZE;
+    std::atomic<size_t> nextChunk{0};
+    auto evaluateChunks = [this, &parameters, &points, &nextChunk, count, chunks]() {
+        for (size_t i = nextChunk++; i < chunks; i = nextChunk++) {
+            const size_t first = i * BULK_SIZE;
+            evaluateRange(parameters.data() + first, points.data() + first,
+                          static_cast<int>(std::min<size_t>(BULK_SIZE, count - first)));
+        }
+    };
+
+    const size_t threads = std::min<size_t>(chunks, std::max(1, QThread::idealThreadCount()));
+    QThreadPool threadPool;
+    for (size_t i = 1; i < threads; ++i) {
+        threadPool.start(evaluateChunks);
+    }
+    evaluateChunks();
+    threadPool.waitForDone();
+    return points;
+}
+
+//Evaluates the equations for count parameters. Called from worker threads, the expression cache of the
+//application is thread safe and the equations it doesn't know get their own parsers.
+void plotSampler::evaluateRange(double* parameters, QPointF* points, int count) const
+{
+    std::vector<double> values1;
+    std::vector<double> values2;
+    try {
+        evaluateEquation(m_equation1, m_variable1, parameters, values1, count);
+        if (!m_equation2.isEmpty()) {
+            evaluateEquation(m_equation2, m_variable2, parameters, values2, count);
+        }
+    }
+    catch (mu::Parser::exception_type &e)
+    {
+        //equations were checked in constructor, this is not expected
+        mu::console() << e.GetMsg() << std::endl;
+        values1.assign(count, NAN);
+        values2.clear();
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (m_equation2.isEmpty()) {
+            points[i] = QPointF(parameters[i], values1[i]);
+        } else if (values2.empty()) {
+            points[i] = QPointF(NAN, NAN);
+        } else {
+            points[i] = QPointF(values1[i], values2[i]);
+        }
+    }
+}
+
+void plotSampler::evaluateEquation(const QString& equation, const QString& variable, double* parameters,
+                                   std::vector<double>& values, int count) const
+{
+    if (!variable.isEmpty()
+            && m_doc->evalBatch(equation, variable, std::vector<double>(parameters, parameters + count), values)) {
+        return;
+    }
+    values.resize(count);
+    mu::Parser p;
+    setupParser(p, parameters);
+    p.SetExpr(toMUPString(equation));
+    p.Eval(values.data(), count);
+}
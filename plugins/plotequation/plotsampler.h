@@ -0,0 +1,44 @@
+#ifndef PLOTSAMPLER_H
+#define PLOTSAMPLER_H
+
+#include <vector>
+
+#include <QPointF>
+#include <QString>
+
+class Document_Interface;
+
+//Samples the curve given by one equation y(x) or by two parametric equations x(t), y(t).
+//Equations are evaluated by the expression cache of the application, or with muParser bulk mode
+//if they use constants the application doesn't know. Large sample sets are split among threads.
+class plotSampler
+{
+public:
+    //throws mu::Parser::exception_type if an equation can't be parsed
+    plotSampler(Document_Interface* doc, const QString& equation1, const QString& equation2);
+
+    //samples at start, start + step, ... up to end
+    std::vector<QPointF> sampleUniform(double start, double end, double step) const;
+    //samples with step at most, segments are split until the distance between the curve and the chord
+    //at their middle is below tolerance
+    std::vector<QPointF> sampleAdaptive(double start, double end, double step, double tolerance) const;
+
+    //number of equation evaluations done so far
+    size_t evaluations() const { return m_evaluations; }
+
+private:
+    std::vector<QPointF> evaluate(std::vector<double>& parameters) const;
+    void evaluateRange(double* parameters, QPointF* points, int count) const;
+    void evaluateEquation(const QString& equation, const QString& variable, double* parameters,
+                          std::vector<double>& values, int count) const;
+
+    Document_Interface* m_doc;
+    QString m_equation1;
+    QString m_equation2;
+    //variable of the equation evaluated by the application, empty if it's evaluated by the plugin
+    QString m_variable1;
+    QString m_variable2;
+    mutable size_t m_evaluations = 0;
+};
+
+#endif // PLOTSAMPLER_H